@@ -0,0 +1,68 @@
+/********************************************************************************
+ * @description: 三种驱动方式的每帧开销
+ *   N 个对象、每个对象 M 个属性的无限循环动画，统计 lv_anim 节点数与每帧耗时；
+ *   删除了显示器刷新定时器，只计算动画本身 (缓动、插值、写样式)，不含布局与绘制
+ ********************************************************************************/
+
+#include "host.h"
+#include "../xanime.c"
+
+#define OBJ_NUM 200
+#define FRAME_NUM 300
+#define FRAME_MS 16
+
+static const char *mode_name[] = {"PROPERTY", "FUSED", "GROUP"};
+
+static void bench_mode(xanime_mode_t mode)
+{
+    static lv_obj_t *objs[OBJ_NUM];
+    lv_obj_t *scr = lv_obj_create(NULL);
+    for (int i = 0; i < OBJ_NUM; i++)
+        objs[i] = lv_obj_create(scr);
+
+    // 6 个属性：x、y、宽、高、透明度、旋转
+    xanime_t *anime = xanime_create_rt((xanime_obj_t){.obj_num = OBJ_NUM, .obj_arr = objs}, (xanime_param_t){
+        .x = "+=100",
+        .y = "+=50",
+        .width = "120",
+        .height = "80",
+        .opacity = "0",
+        .rotate = "90",
+        .dur = "1000",
+        .loop = "-1",
+        .auto_play = true,
+        .mode = mode,
+    });
+    if (!anime)
+    {
+        printf("Error: %s create failed\n", mode_name[mode]);
+        return;
+    }
+
+    // 预热，所有动画都已开始
+    for (int i = 0; i < 10; i++)
+        host_frame(FRAME_MS);
+
+    uint64_t t0 = host_now_ns();
+    for (int i = 0; i < FRAME_NUM; i++)
+        host_frame(FRAME_MS);
+    uint64_t t1 = host_now_ns();
+
+    printf("%-9s mode=%-8s lv_anim=%5u  %8.1f us/frame\n", mode_name[mode], mode_name[anime->spec.mode],
+           (unsigned)lv_anim_count_running(), (double)(t1 - t0) / FRAME_NUM / 1000.0);
+
+    xanime_delete(anime);
+    lv_obj_delete(scr);
+}
+
+int main(void)
+{
+    lv_display_t *disp = host_init();
+    lv_display_delete_refr_timer(disp);
+
+    printf("%d objects x 6 props, %d frames\n", OBJ_NUM, FRAME_NUM);
+    bench_mode(XANIME_MODE_PROPERTY);
+    bench_mode(XANIME_MODE_FUSED);
+    bench_mode(XANIME_MODE_GROUP);
+    return 0;
+}
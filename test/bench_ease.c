@@ -0,0 +1,165 @@
+/********************************************************************************
+ * @description: 缓动查找表与 Penner 公式的对比
+ *   对每条内置曲线在全部 Q10 进度上统计查找表的最大误差，
+ *   并比较查找表与浮点公式每次求值的耗时
+ ********************************************************************************/
+
+#include "host.h"
+#include "../xanime.c"
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define BENCH_ROUNDS 2000
+
+static double pen_sine(double t) { return 1 - cos(t * M_PI / 2); }
+static double pen_quad(double t) { return t * t; }
+static double pen_cubic(double t) { return t * t * t; }
+static double pen_quart(double t) { return t * t * t * t; }
+
+static double pen_back(double t)
+{
+    const double c1 = 1.70158, c3 = c1 + 1;
+    return c3 * t * t * t - c1 * t * t;
+}
+
+static double pen_elastic(double t)
+{
+    const double c4 = 2 * M_PI / 3;
+    if (t <= 0 || t >= 1)
+        return t <= 0 ? 0 : 1;
+    return -pow(2, 10 * t - 10) * sin((t * 10 - 10.75) * c4);
+}
+
+static double pen_bounce_out(double t)
+{
+    const double n1 = 7.5625, d1 = 2.75;
+    if (t < 1 / d1)
+        return n1 * t * t;
+    if (t < 2 / d1)
+    {
+        t -= 1.5 / d1;
+        return n1 * t * t + 0.75;
+    }
+    if (t < 2.5 / d1)
+    {
+        t -= 2.25 / d1;
+        return n1 * t * t + 0.9375;
+    }
+    t -= 2.625 / d1;
+    return n1 * t * t + 0.984375;
+}
+
+static double pen_bounce(double t) { return 1 - pen_bounce_out(1 - t); }
+
+static double pen_back_in_out(double t)
+{
+    const double c2 = 1.70158 * 1.525;
+    return t < 0.5 ? (pow(2 * t, 2) * ((c2 + 1) * 2 * t - c2)) / 2
+                   : (pow(2 * t - 2, 2) * ((c2 + 1) * (t * 2 - 2) + c2) + 2) / 2;
+}
+
+static double pen_elastic_in_out(double t)
+{
+    const double c5 = 2 * M_PI / 4.5;
+    if (t <= 0 || t >= 1)
+        return t <= 0 ? 0 : 1;
+    return t < 0.5 ? -(pow(2, 20 * t - 10) * sin((20 * t - 11.125) * c5)) / 2
+                   : (pow(2, -20 * t + 10) * sin((20 * t - 11.125) * c5)) / 2 + 1;
+}
+
+typedef struct
+{
+    const char *name;
+    xanime_easing_t easing;
+    double (*in)(double t);
+    // 为 1 时 in 已是 IN_OUT 曲线
+    bool in_out;
+    uint8_t kind;
+} curve_t;
+
+#define CURVE3(name, id, fn)                                                      \
+    {"in_" name, XANIME_EASE_IN_##id, fn, false, EASE_KIND_IN},                  \
+        {"out_" name, XANIME_EASE_OUT_##id, fn, false, EASE_KIND_OUT},           \
+        {"in_out_" name, XANIME_EASE_IN_OUT_##id, fn, false, EASE_KIND_IN_OUT}
+
+static const curve_t curves[] = {
+    CURVE3("sine", SINE, pen_sine),
+    CURVE3("quad", QUAD, pen_quad),
+    CURVE3("cubic", CUBIC, pen_cubic),
+    CURVE3("quart", QUART, pen_quart),
+    {"in_back", XANIME_EASE_IN_BACK, pen_back, false, EASE_KIND_IN},
+    {"out_back", XANIME_EASE_OUT_BACK, pen_back, false, EASE_KIND_OUT},
+    {"in_out_back", XANIME_EASE_IN_OUT_BACK, pen_back_in_out, true, EASE_KIND_IN_OUT},
+    {"in_elastic", XANIME_EASE_IN_ELASTIC, pen_elastic, false, EASE_KIND_IN},
+    {"out_elastic", XANIME_EASE_OUT_ELASTIC, pen_elastic, false, EASE_KIND_OUT},
+    {"in_out_elastic", XANIME_EASE_IN_OUT_ELASTIC, pen_elastic_in_out, true, EASE_KIND_IN_OUT},
+    CURVE3("bounce", BOUNCE, pen_bounce),
+};
+
+/****
+ * @brief: 按 Penner 公式计算曲线
+ * @param {curve_t} *c
+ * @param {double} t [0, 1]
+ * @return {*}
+ ****/
+static double curve_ref(const curve_t *c, double t)
+{
+    if (c->in_out)
+        return c->in(t);
+    switch (c->kind)
+    {
+    case EASE_KIND_OUT:
+        return 1 - c->in(1 - t);
+    case EASE_KIND_IN_OUT:
+        return t < 0.5 ? c->in(2 * t) / 2 : 1 - c->in(2 - 2 * t) / 2;
+    default:
+        return c->in(t);
+    }
+}
+
+int main(void)
+{
+    volatile int32_t lut_sink = 0;
+    volatile double ref_sink = 0;
+    double worst = 0;
+
+    printf("%-16s %9s %7s %10s %10s\n", "curve", "max_err", "at_t", "lut_ns", "ref_ns");
+    for (size_t n = 0; n < sizeof(curves) / sizeof(curves[0]); n++)
+    {
+        const curve_t *c = &curves[n];
+        double max_err = 0;
+        int32_t max_at = 0;
+        for (int32_t t = 0; t <= XANIME_PROGRESS_MAX; t++)
+        {
+            double err = fabs(ease_eval(c->easing, t) - curve_ref(c, (double)t / XANIME_PROGRESS_MAX) * XANIME_PROGRESS_MAX);
+            if (err > max_err)
+            {
+                max_err = err;
+                max_at = t;
+            }
+        }
+        if (max_err > worst)
+            worst = max_err;
+
+        uint64_t t0 = host_now_ns();
+        for (int r = 0; r < BENCH_ROUNDS; r++)
+            for (int32_t t = 0; t <= XANIME_PROGRESS_MAX; t++)
+                lut_sink += ease_eval(c->easing, t);
+        uint64_t t1 = host_now_ns();
+        for (int r = 0; r < BENCH_ROUNDS; r++)
+            for (int32_t t = 0; t <= XANIME_PROGRESS_MAX; t++)
+                ref_sink += curve_ref(c, (double)t / XANIME_PROGRESS_MAX);
+        uint64_t t2 = host_now_ns();
+
+        double evals = (double)BENCH_ROUNDS * (XANIME_PROGRESS_MAX + 1);
+        printf("%-16s %6.2f/1024 %7.4f %10.2f %10.2f\n", c->name, max_err, (double)max_at / XANIME_PROGRESS_MAX,
+               (t1 - t0) / evals, (t2 - t1) / evals);
+    }
+    printf("worst %.2f/1024\n", worst);
+    (void)lut_sink;
+    (void)ref_sink;
+    return 0;
+}
@@ -0,0 +1,90 @@
+/********************************************************************************
+ * @description: 位置动画每帧触发的布局次数
+ *   容器使用一个计数的自定义布局 (按行排列子对象)，浮动的子对象做 x / y 往返动画，
+ *   分别统计坐标动画与 translate 动画 (use_translate) 平均每帧执行布局的次数
+ ********************************************************************************/
+
+#include "host.h"
+#include "../xanime.c"
+
+#define SIBLING_NUM 10
+#define FRAME_NUM 300
+#define FRAME_MS 16
+
+static uint32_t layout_cnt;
+
+// 按行排列没有忽略布局的子对象，同时统计执行次数
+static void count_layout_cb(lv_obj_t *cont, void *user_data)
+{
+    (void)user_data;
+    layout_cnt++;
+    int32_t x = 0;
+    uint32_t n = lv_obj_get_child_count(cont);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        lv_obj_t *child = lv_obj_get_child(cont, (int32_t)i);
+        if (lv_obj_has_flag_any(child, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_FLOATING | LV_OBJ_FLAG_HIDDEN))
+            continue;
+        lv_obj_set_pos(child, x, 0);
+        x += lv_obj_get_width(child) + 4;
+    }
+}
+
+static void bench_layout(uint32_t layout, xanime_mode_t mode, bool use_translate)
+{
+    static const char *mode_name[] = {"PROPERTY", "FUSED", "GROUP"};
+    lv_obj_t *scr = lv_obj_create(NULL);
+    lv_screen_load(scr);
+    lv_obj_t *cont = lv_obj_create(scr);
+    lv_obj_set_size(cont, 760, 200);
+    lv_obj_set_layout(cont, layout);
+    for (int i = 0; i < SIBLING_NUM; i++)
+        lv_obj_set_size(lv_obj_create(cont), 50, 50);
+    lv_obj_t *mover = lv_obj_create(cont);
+    lv_obj_set_size(mover, 40, 40);
+    lv_obj_add_flag(mover, LV_OBJ_FLAG_FLOATING);
+    lv_obj_set_pos(mover, 0, 100);
+
+    // 让第一次布局在计数之前完成
+    host_frame(FRAME_MS);
+    layout_cnt = 0;
+
+    xanime_t *anime = xanime_create_rt((xanime_obj_t){.obj_num = 1, .obj_arr = &mover}, (xanime_param_t){
+        .x = "+=600",
+        .y = "+=40",
+        .dur = "1000",
+        .loop = "-1",
+        .auto_play = true,
+        .mode = mode,
+        .use_translate = use_translate,
+    });
+    // 开始时提交终点坐标的那次布局单独统计
+    host_frame(FRAME_MS);
+    uint32_t start_cnt = layout_cnt;
+    layout_cnt = 0;
+
+    uint64_t t0 = host_now_ns();
+    for (int i = 0; i < FRAME_NUM; i++)
+        host_frame(FRAME_MS);
+    uint64_t t1 = host_now_ns();
+
+    printf("%-8s translate=%d  start %2u  %5.2f layout/frame  %8.1f us/frame\n", mode_name[mode], use_translate,
+           (unsigned)start_cnt, (double)layout_cnt / FRAME_NUM, (double)(t1 - t0) / FRAME_NUM / 1000.0);
+
+    xanime_delete(anime);
+    lv_obj_delete(scr);
+}
+
+int main(void)
+{
+    host_init();
+    uint32_t layout = lv_layout_register(count_layout_cb, NULL);
+
+    printf("%d siblings, 1 floating mover, %d frames\n", SIBLING_NUM, FRAME_NUM);
+    for (int mode = XANIME_MODE_PROPERTY; mode <= XANIME_MODE_GROUP; mode++)
+    {
+        bench_layout(layout, (xanime_mode_t)mode, false);
+        bench_layout(layout, (xanime_mode_t)mode, true);
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+/********************************************************************************
+ * @description: 主机测试公用部分：无输出的显示器、手动推进的时钟与计时
+ ********************************************************************************/
+
+#ifndef XANIME_TEST_HOST_H
+#define XANIME_TEST_HOST_H
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include "lvgl.h"
+
+#define HOST_HOR_RES 800
+#define HOST_VER_RES 480
+
+// 行为测试每次推进的时间，与动画定时器和驱动定时器的周期相同，每帧都会执行
+#define HOST_FRAME_MS LV_DEF_REFR_PERIOD
+
+// 行为测试失败的检查数量
+static int host_fail_num;
+
+static uint8_t host_draw_buf[HOST_HOR_RES * 40 * 2];
+
+static inline void host_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    (void)area;
+    (void)px_map;
+    lv_display_flush_ready(disp);
+}
+
+/****
+ * @brief: 初始化 LVGL 与一个不输出的显示器
+ * @return {*} 显示器
+ ****/
+static inline lv_display_t *host_init(void)
+{
+    lv_init();
+    lv_display_t *disp = lv_display_create(HOST_HOR_RES, HOST_VER_RES);
+    lv_display_set_flush_cb(disp, host_flush_cb);
+    lv_display_set_buffers(disp, host_draw_buf, NULL, sizeof(host_draw_buf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    return disp;
+}
+
+/****
+ * @brief: 推进时钟并处理一次定时器 (动画、刷新)
+ * @param {uint32_t} ms 推进的毫秒数
+ ****/
+static inline void host_frame(uint32_t ms)
+{
+    lv_tick_inc(ms);
+    lv_timer_handler();
+}
+
+/****
+ * @brief: 按 HOST_FRAME_MS 逐帧推进一段时间
+ * @param {uint32_t} ms 推进的毫秒数
+ ****/
+static inline void host_run(uint32_t ms)
+{
+    for (uint32_t t = 0; t < ms; t += HOST_FRAME_MS)
+        host_frame(HOST_FRAME_MS);
+}
+
+/****
+ * @brief: 读取对象 x 坐标，先刷新布局，读到的是本帧写入的值
+ * @param {lv_obj_t} *obj
+ * @return {*}
+ ****/
+static inline int32_t host_get_x(lv_obj_t *obj)
+{
+    lv_obj_update_layout(obj);
+    return lv_obj_get_x(obj);
+}
+
+/****
+ * @brief: 行为检查，失败时打印用例名称与实际值
+ * @param {bool} ok 检查是否通过
+ * @param {char} *what 用例名称
+ * @param {long} value 实际值
+ ****/
+static inline void host_check(bool ok, const char *what, long value)
+{
+    if (ok)
+        return;
+    printf("FAIL %s: got %ld\n", what, value);
+    host_fail_num++;
+}
+
+/****
+ * @brief: 打印测试结果
+ * @param {char} *name 测试名称
+ * @return {*} 进程退出码
+ ****/
+static inline int host_result(const char *name)
+{
+    printf("%s: %s\n", name, host_fail_num ? "FAILED" : "ok");
+    return host_fail_num ? 1 : 0;
+}
+
+/****
+ * @brief: 单调时钟
+ * @return {*} 纳秒
+ ****/
+static inline uint64_t host_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+#endif // XANIME_TEST_HOST_H
@@ -0,0 +1,13 @@
+/********************************************************************************
+ * @description: 主机测试使用的 LVGL 配置，未列出的选项使用 LVGL 的默认值
+ ********************************************************************************/
+
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+#define LV_COLOR_DEPTH 16
+
+// 基准测试一次创建数百个对象与动画
+#define LV_MEM_SIZE (8 * 1024 * 1024U)
+
+#endif // LV_CONF_H
@@ -0,0 +1,145 @@
+/********************************************************************************
+ * @description: 控制器事件测试
+ *   多对象、多属性、错开播放与循环时每个控制器只派发一次开始、循环与完成，
+ *   同时存在的控制器超过句柄表大小时照常派发，已删除的控制器的事件被丢弃
+ ********************************************************************************/
+
+#include "host.h"
+#include "../xanime.c"
+
+#define OBJ_NUM 5
+#define MANY_NUM (XANIME_HANDLE_NUM + 8)
+
+typedef struct
+{
+    int start;
+    int update;
+    int repeat;
+    int complete;
+} event_count_t;
+
+static xanime_t *many[MANY_NUM];
+static event_count_t counts[MANY_NUM];
+static int victim = -1;
+
+static void count_event_cb(xanime_t *anime, xanime_event_t event)
+{
+    event_count_t *count = anime->spec.user_data;
+    switch (event)
+    {
+    case XANIME_EVENT_START:
+        count->start++;
+        break;
+    case XANIME_EVENT_UPDATE:
+        count->update++;
+        break;
+    case XANIME_EVENT_REPEAT:
+        count->repeat++;
+        break;
+    case XANIME_EVENT_COMPLETE:
+        count->complete++;
+        break;
+    }
+}
+
+// 第一个派发的完成事件删除另一个同一帧完成、完成事件还在队列中的控制器
+static void delete_other_cb(xanime_t *anime, xanime_event_t event)
+{
+    count_event_cb(anime, event);
+    if (event != XANIME_EVENT_COMPLETE || victim >= 0)
+        return;
+    for (int i = MANY_NUM - 1; i >= 0; i--)
+    {
+        if (many[i] != anime && counts[i].complete == 0)
+        {
+            victim = i;
+            xanime_delete(many[i]);
+            many[i] = NULL;
+            return;
+        }
+    }
+}
+
+static void test_aggregate(lv_obj_t **objs, xanime_mode_t mode, const char *what)
+{
+    event_count_t count = {0};
+    char name[64];
+    xanime_t *anime = xanime_create_rt((xanime_obj_t){.obj_num = OBJ_NUM, .obj_arr = objs}, (xanime_param_t){
+        .x = "+=100",
+        .opacity = "0",
+        .dur = "200",
+        .loop = "2",
+        .stagger = "30",
+        .mode = mode,
+        .event_cb = count_event_cb,
+        .user_data = &count,
+    });
+    xanime_start(anime);
+    host_run(1000);
+
+    snprintf(name, sizeof(name), "%s start once", what);
+    host_check(count.start == 1, name, count.start);
+    snprintf(name, sizeof(name), "%s repeat once", what);
+    host_check(count.repeat == 1, name, count.repeat);
+    snprintf(name, sizeof(name), "%s complete once", what);
+    host_check(count.complete == 1, name, count.complete);
+    // 每帧最多一次，与对象和属性数量无关
+    snprintf(name, sizeof(name), "%s update per frame", what);
+    host_check(count.update > 0 && count.update <= 1000 / HOST_FRAME_MS + 1, name, count.update);
+
+    xanime_delete(anime);
+}
+
+static void test_many(lv_obj_t *scr)
+{
+    static lv_obj_t *objs[MANY_NUM];
+    for (int i = 0; i < MANY_NUM; i++)
+    {
+        objs[i] = lv_obj_create(scr);
+        counts[i] = (event_count_t){0};
+        many[i] = xanime_create_rt((xanime_obj_t){.obj_num = 1, .obj_arr = &objs[i]}, (xanime_param_t){
+            .x = "100",
+            .dur = "100",
+            .mode = i % 2 ? XANIME_MODE_GROUP : XANIME_MODE_FUSED,
+            .event_cb = delete_other_cb,
+            .user_data = &counts[i],
+        });
+        xanime_start(many[i]);
+    }
+    host_check(xanime_get_handle(many[MANY_NUM - 1]) == XANIME_HANDLE_INVALID, "handle table full", 0);
+    host_run(300);
+
+    host_check(victim >= 0 && counts[victim].complete == 0, "deleted controller's event dropped", victim);
+    for (int i = 0; i < MANY_NUM; i++)
+    {
+        if (i != victim && (counts[i].start != 1 || counts[i].complete != 1))
+        {
+            host_check(false, "events without a handle", i);
+            break;
+        }
+    }
+
+    for (int i = 0; i < MANY_NUM; i++)
+    {
+        xanime_delete(many[i]);
+        lv_obj_delete(objs[i]);
+    }
+}
+
+int main(void)
+{
+    host_init();
+    lv_obj_t *scr = lv_screen_active();
+    lv_obj_t *objs[OBJ_NUM];
+    for (int i = 0; i < OBJ_NUM; i++)
+        objs[i] = lv_obj_create(scr);
+    host_frame(HOST_FRAME_MS);
+
+    test_aggregate(objs, XANIME_MODE_GROUP, "group");
+    test_aggregate(objs, XANIME_MODE_FUSED, "fused");
+    test_many(scr);
+
+    for (int i = 0; i < OBJ_NUM; i++)
+        lv_obj_delete(objs[i]);
+    return host_result("event");
+}
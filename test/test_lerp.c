@@ -0,0 +1,173 @@
+/********************************************************************************
+ * @description: 批量插值测试
+ *   lerp_batch 的 SIMD 实现 (按编译参数选择 AVX2 / SSE2 / NEON / 标量) 与
+ *   lerp_batch_wide 逐元素对比 64 位标量公式，覆盖随机差值、INT32 边界与
+ *   不是向量宽度整数倍的长度
+ ********************************************************************************/
+
+#include "host.h"
+#include "../xanime.c"
+
+#define TEST_MAX_N 1000
+
+static uint32_t rng_state = 0x12345678u;
+static int fail_num;
+
+static uint32_t rng(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// [lo, hi] 内的随机数
+static int32_t rng_range(int32_t lo, int32_t hi)
+{
+    return (int32_t)((int64_t)lo + (int64_t)(rng() % ((uint64_t)((int64_t)hi - lo) + 1)));
+}
+
+static int32_t lerp_ref(int32_t from, int32_t to, int32_t progress)
+{
+    return (int32_t)(from + ((((int64_t)to - from) * progress) >> XANIME_PROGRESS_SHIFT));
+}
+
+/****
+ * @brief: 两种实现与标量公式对比，出错时打印第一个不同的元素
+ * @param {char} *what 用例名称
+ * @param {int} wide 是否为 64 位实现
+ ****/
+static void check(const char *what, bool wide, const int32_t *from, const int32_t *to, uint32_t n, int32_t progress)
+{
+    // 多一个元素检查越界写入
+    static int32_t out[TEST_MAX_N + 1];
+    out[n] = 0x5a5a5a5a;
+    if (wide)
+        lerp_batch_wide(from, to, out, n, progress);
+    else
+        lerp_batch(from, to, out, n, progress);
+    if (out[n] != 0x5a5a5a5a)
+    {
+        printf("FAIL %s: n=%u wrote past the end\n", what, (unsigned)n);
+        fail_num++;
+        return;
+    }
+    for (uint32_t i = 0; i < n; i++)
+    {
+        int32_t ref = lerp_ref(from[i], to[i], progress);
+        if (out[i] != ref)
+        {
+            printf("FAIL %s: n=%u i=%u from=%ld to=%ld p=%ld got %ld want %ld\n", what, (unsigned)n, (unsigned)i,
+                   (long)from[i], (long)to[i], (long)progress, (long)out[i], (long)ref);
+            fail_num++;
+            return;
+        }
+    }
+}
+
+// 缓动后的进度，回拉与弹性曲线会超出 [0, XANIME_PROGRESS_MAX]
+static const int32_t progress_edges[] = {0, 1, 511, 512, 1023, XANIME_PROGRESS_MAX, -400, 1430};
+
+static void test_narrow(void)
+{
+    static int32_t from[TEST_MAX_N], to[TEST_MAX_N];
+    for (uint32_t k = 0; k <= 68; k++)
+    {
+        // 0 到 67 覆盖各种剩余长度，最后一次为长数组
+        uint32_t n = k < 68 ? k : TEST_MAX_N;
+        for (int round = 0; round < 20; round++)
+        {
+            // 随机起点与差值，差值包含 ±LERP_NARROW_MAX
+            for (uint32_t i = 0; i < n; i++)
+            {
+                int32_t d = (i % 7 == 0) ? ((i & 8) ? LERP_NARROW_MAX : -LERP_NARROW_MAX) : rng_range(-LERP_NARROW_MAX, LERP_NARROW_MAX);
+                from[i] = rng_range(-1000000, 1000000);
+                to[i] = from[i] + d;
+            }
+            int32_t p = round < 8 ? progress_edges[round] : rng_range(-400, 1430);
+            check("narrow", false, from, to, n, p);
+            check("narrow/wide", true, from, to, n, p);
+
+            // INT32 边界附近的起点，进度不超出 [0, XANIME_PROGRESS_MAX]，结果不会溢出
+            for (uint32_t i = 0; i < n; i++)
+            {
+                int32_t d = rng_range(0, LERP_NARROW_MAX);
+                if (i & 1)
+                {
+                    from[i] = INT32_MAX - (int32_t)(rng() % 4) - (i & 2 ? d : 0);
+                    to[i] = i & 2 ? from[i] + d : from[i] - d;
+                }
+                else
+                {
+                    from[i] = INT32_MIN + (int32_t)(rng() % 4) + (i & 2 ? d : 0);
+                    to[i] = i & 2 ? from[i] - d : from[i] + d;
+                }
+            }
+            p = round < 6 ? progress_edges[round] : rng_range(0, XANIME_PROGRESS_MAX);
+            check("narrow/int32", false, from, to, n, p);
+            check("narrow/int32/wide", true, from, to, n, p);
+        }
+    }
+}
+
+static void test_wide(void)
+{
+    static int32_t from[TEST_MAX_N], to[TEST_MAX_N];
+    if (lerp_is_narrow(0, LERP_NARROW_MAX + 1) || lerp_is_narrow(0, -LERP_NARROW_MAX - 1) ||
+        !lerp_is_narrow(INT32_MAX, INT32_MAX - LERP_NARROW_MAX) || lerp_is_narrow(INT32_MIN, INT32_MAX))
+    {
+        printf("FAIL lerp_is_narrow boundary\n");
+        fail_num++;
+    }
+    for (uint32_t k = 0; k <= 68; k++)
+    {
+        uint32_t n = k < 68 ? k : TEST_MAX_N;
+        for (int round = 0; round < 20; round++)
+        {
+            for (uint32_t i = 0; i < n; i++)
+            {
+                switch (i % 4)
+                {
+                case 0:
+                    from[i] = INT32_MIN;
+                    to[i] = INT32_MAX;
+                    break;
+                case 1:
+                    from[i] = INT32_MAX;
+                    to[i] = INT32_MIN;
+                    break;
+                default:
+                    from[i] = (int32_t)rng();
+                    to[i] = (int32_t)rng();
+                    break;
+                }
+            }
+            int32_t p = round < 6 ? progress_edges[round] : rng_range(0, XANIME_PROGRESS_MAX);
+            check("wide", true, from, to, n, p);
+        }
+    }
+}
+
+int main(void)
+{
+#if defined(LERP_AVX2)
+    const char *kernel = "avx2";
+#elif defined(LERP_SSE2)
+    const char *kernel = "sse2";
+#elif defined(LERP_NEON)
+    const char *kernel = "neon";
+#else
+    const char *kernel = "scalar";
+#endif
+#if defined(LERP_AVX2) && (defined(__GNUC__) || defined(__clang__))
+    if (!__builtin_cpu_supports("avx2"))
+    {
+        printf("lerp %s: skipped, cpu has no avx2\n", kernel);
+        return 0;
+    }
+#endif
+    test_narrow();
+    test_wide();
+    printf("lerp %s: %s\n", kernel, fail_num ? "FAILED" : "ok");
+    return fail_num ? 1 : 0;
+}
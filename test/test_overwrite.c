@@ -0,0 +1,129 @@
+/********************************************************************************
+ * @description: 覆盖策略测试
+ *   AUTO 只停止冲突的属性，ALL 停止对象上的所有旧动画，NONE 不登记到 (对象, 属性) 索引；
+ *   被停止的属性不再写入，被停止的动画不触发完成回调，结束后索引为空
+ ********************************************************************************/
+
+#include "host.h"
+#include "../xanime.c"
+
+static int complete_num[2];
+
+static void complete_old_cb(lv_anim_t *a)
+{
+    complete_num[0]++;
+}
+
+static void complete_new_cb(lv_anim_t *a)
+{
+    complete_num[1]++;
+}
+
+static void test_auto(lv_obj_t *obj)
+{
+    complete_num[0] = complete_num[1] = 0;
+    xanime_t *old = xanime_create_single_rt(obj, (xanime_param_t){
+        .x = "400",
+        .opacity = "0",
+        .dur = "400",
+        .mode = XANIME_MODE_GROUP,
+        .overwrite = XANIME_OVERWRITE_AUTO,
+        .complete_cb = complete_old_cb,
+    });
+    xanime_start(old);
+    host_check(claim_index.count == 2, "auto claims x and opacity", (long)claim_index.count);
+    host_run(100);
+    int32_t x = host_get_x(obj);
+
+    // 融合模式的新动画接管 x，旧动画的透明度继续
+    xanime_t *new = xanime_create_single_rt(obj, (xanime_param_t){
+        .x = "0",
+        .dur = "200",
+        .mode = XANIME_MODE_FUSED,
+        .overwrite = XANIME_OVERWRITE_AUTO,
+        .complete_cb = complete_new_cb,
+    });
+    xanime_start(new);
+    host_run(100);
+    host_check(host_get_x(obj) < x, "auto: new animation owns x", host_get_x(obj));
+    lv_opa_t opa = lv_obj_get_style_opa(obj, LV_PART_MAIN);
+    host_check(opa > 0 && opa < LV_OPA_COVER, "auto: old opacity keeps running", opa);
+
+    host_run(300);
+    host_check(host_get_x(obj) == 0, "auto: x ends at new target", host_get_x(obj));
+    host_check(lv_obj_get_style_opa(obj, LV_PART_MAIN) == 0, "auto: opacity ends at old target",
+               lv_obj_get_style_opa(obj, LV_PART_MAIN));
+    host_check(complete_num[0] == 1 && complete_num[1] == 1, "auto: both complete", complete_num[0]);
+    host_check(claim_index.count == 0, "auto: index empty after both finish", (long)claim_index.count);
+
+    xanime_delete(old);
+    xanime_delete(new);
+}
+
+static void test_all(lv_obj_t *obj)
+{
+    complete_num[0] = complete_num[1] = 0;
+    xanime_t *old = xanime_create_single_rt(obj, (xanime_param_t){
+        .x = "400",
+        .dur = "400",
+        .mode = XANIME_MODE_GROUP,
+        .overwrite = XANIME_OVERWRITE_AUTO,
+        .complete_cb = complete_old_cb,
+    });
+    xanime_start(old);
+    host_run(100);
+    int32_t x = host_get_x(obj);
+
+    // 不冲突的属性也停止整个旧动画
+    xanime_t *new = xanime_create_single_rt(obj, (xanime_param_t){
+        .opacity = "255",
+        .dur = "200",
+        .mode = XANIME_MODE_GROUP,
+        .overwrite = XANIME_OVERWRITE_ALL,
+        .complete_cb = complete_new_cb,
+    });
+    xanime_start(new);
+    // 组动画在驱动的下一帧结束
+    host_frame(HOST_FRAME_MS);
+    host_check(!old->is_playing, "all: old animation stopped", old->is_playing);
+    host_run(300);
+    host_check(host_get_x(obj) == x, "all: stopped x stays at current value", host_get_x(obj));
+    host_check(complete_num[0] == 0 && complete_num[1] == 1, "all: only new completes", complete_num[0]);
+    host_check(claim_index.count == 0, "all: index empty", (long)claim_index.count);
+
+    // 被停止的动画重新播放后恢复
+    xanime_restart(old);
+    host_run(500);
+    host_check(host_get_x(obj) == 400 && complete_num[0] == 1, "all: restart resumes stopped animation",
+               host_get_x(obj));
+
+    xanime_delete(old);
+    xanime_delete(new);
+}
+
+static void test_none(lv_obj_t *obj)
+{
+    xanime_t *anime = xanime_create_single_rt(obj, (xanime_param_t){
+        .x = "0",
+        .dur = "100",
+        .mode = XANIME_MODE_GROUP,
+    });
+    xanime_start(anime);
+    host_check(claim_index.count == 0, "none: not registered", (long)claim_index.count);
+    host_run(200);
+    xanime_delete(anime);
+}
+
+int main(void)
+{
+    host_init();
+    lv_obj_t *obj = lv_obj_create(lv_screen_active());
+    host_frame(HOST_FRAME_MS);
+
+    test_auto(obj);
+    test_all(obj);
+    test_none(obj);
+
+    lv_obj_delete(obj);
+    return host_result("overwrite");
+}
@@ -0,0 +1,105 @@
+/********************************************************************************
+ * @description: 播放控制测试
+ *   组模式的暂停、继续、跳转、反向、时间缩放与重新播放，只检查写入对象的值，
+ *   允许一帧的误差
+ ********************************************************************************/
+
+#include "host.h"
+#include "../xanime.c"
+
+static int complete_num;
+
+static void complete_cb(lv_anim_t *a)
+{
+    complete_num++;
+}
+
+// 与期望值相差不超过一帧的移动距离 (1 px/ms)
+static bool near(int32_t value, int32_t want)
+{
+    return value >= want - HOST_FRAME_MS && value <= want + HOST_FRAME_MS;
+}
+
+int main(void)
+{
+    host_init();
+    lv_obj_t *obj = lv_obj_create(lv_screen_active());
+    host_frame(HOST_FRAME_MS);
+
+    // 0 -> 400，1 px/ms
+    xanime_t *anime = xanime_create_single_rt(obj, (xanime_param_t){
+        .x = "400",
+        .dur = "400",
+        .mode = XANIME_MODE_GROUP,
+        .complete_cb = complete_cb,
+    });
+
+    xanime_start(anime);
+    host_run(100);
+    int32_t x = host_get_x(obj);
+    host_check(near(x, 100), "play 100ms", x);
+
+    // 暂停期间不前进
+    xanime_pause(anime);
+    host_check(anime->is_paused && !anime->is_playing, "paused state", anime->is_paused);
+    host_run(200);
+    host_check(host_get_x(obj) == x, "paused holds value", host_get_x(obj));
+
+    xanime_resume(anime);
+    host_run(100);
+    x = host_get_x(obj);
+    host_check(near(x, 200), "resume continues from pause", x);
+
+    // 跳转立即写入
+    xanime_seek(anime, 300);
+    host_check(host_get_x(obj) == 300, "seek writes immediately", host_get_x(obj));
+    host_check(xanime_get_time(anime) == 300, "seek time", (long)xanime_get_time(anime));
+
+    // 从当前位置反向
+    xanime_reverse(anime);
+    host_run(100);
+    x = host_get_x(obj);
+    host_check(near(x, 200), "reverse plays backwards", x);
+
+    // 再次反向恢复正向，2 倍速
+    xanime_reverse(anime);
+    xanime_seek(anime, 0);
+    xanime_set_timescale(anime, XANIME_TIMESCALE_NORMAL * 2);
+    host_run(100);
+    x = host_get_x(obj);
+    host_check(x >= 200 - 2 * HOST_FRAME_MS && x <= 200 + 2 * HOST_FRAME_MS, "timescale x2", x);
+
+    complete_num = 0;
+    host_run(300);
+    host_check(host_get_x(obj) == 400 && !anime->is_playing, "finished at end value", host_get_x(obj));
+    host_check(complete_num == 1, "complete once", complete_num);
+
+    // 结束后反向重新播放，回到起点时同样完成
+    xanime_set_timescale(anime, XANIME_TIMESCALE_NORMAL);
+    xanime_reverse(anime);
+    host_check(anime->is_playing, "reverse restarts finished animation", anime->is_playing);
+    host_run(500);
+    host_check(host_get_x(obj) == 0 && complete_num == 2, "reverse completes at start", host_get_x(obj));
+
+    // 重新播放沿用第一次启动时的起点
+    lv_obj_set_x(obj, 50);
+    xanime_restart(anime);
+    host_run(HOST_FRAME_MS);
+    x = host_get_x(obj);
+    host_check(x >= 0 && x <= 2 * HOST_FRAME_MS, "restart from first start value", x);
+    xanime_delete(anime);
+
+    // 融合模式由 LVGL 动画驱动，不支持播放控制
+    xanime_t *fused = xanime_create_single_rt(obj, (xanime_param_t){
+        .x = "100",
+        .dur = "100",
+        .mode = XANIME_MODE_FUSED,
+    });
+    xanime_start(fused);
+    host_check(xanime_seek(fused, 50) == NULL, "fused seek rejected", 0);
+    host_check(xanime_reverse(fused) == NULL, "fused reverse rejected", 0);
+    xanime_delete(fused);
+
+    lv_obj_delete(obj);
+    return host_result("playback");
+}
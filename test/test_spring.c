@@ -0,0 +1,156 @@
+/********************************************************************************
+ * @description: 弹簧动画测试
+ *   欠阻尼弹簧越过目标后静止在目标值，中途改变目标值时位置连续，静止后改变目标值重新开始，
+ *   惯性滑动按阻尼停下，大距离与大初速度下积分不溢出 (配合 -fsanitize=undefined 运行)
+ ********************************************************************************/
+
+#include "host.h"
+#include "../xanime.c"
+
+static int start_num;
+static int complete_num;
+
+static void event_cb(xanime_t *anime, xanime_event_t event)
+{
+    if (event == XANIME_EVENT_START)
+        start_num++;
+    else if (event == XANIME_EVENT_COMPLETE)
+        complete_num++;
+}
+
+// 推进到静止或超时，返回用时
+static uint32_t run_until_rest(xanime_t *anime, uint32_t max_ms)
+{
+    uint32_t t = 0;
+    while (anime->is_playing && t < max_ms)
+    {
+        host_frame(HOST_FRAME_MS);
+        t += HOST_FRAME_MS;
+    }
+    // 事件在动画定时器之后派发
+    host_frame(HOST_FRAME_MS);
+    return t;
+}
+
+static void test_settle(lv_obj_t *obj)
+{
+    static const xanime_spring_t bouncy = {.stiffness = 170, .damping = 12};
+    lv_obj_set_x(obj, 0);
+    start_num = complete_num = 0;
+    xanime_t *anime = xanime_create_single_rt(obj, (xanime_param_t){
+        .x = "100",
+        .spring = &bouncy,
+        .event_cb = event_cb,
+    });
+
+    xanime_start(anime);
+    int32_t max = 0;
+    uint32_t t = 0;
+    while (anime->is_playing && t < 5000)
+    {
+        host_frame(HOST_FRAME_MS);
+        t += HOST_FRAME_MS;
+        int32_t x = host_get_x(obj);
+        max = x > max ? x : max;
+    }
+    host_frame(HOST_FRAME_MS);
+    host_check(max > 100, "underdamped spring overshoots", max);
+    host_check(!anime->is_playing && t < 5000, "spring settles before max duration", (long)t);
+    host_check(host_get_x(obj) == 100, "spring rests on target", host_get_x(obj));
+    host_check(start_num == 1 && complete_num == 1, "start and complete once", complete_num);
+
+    // 弹簧没有固定的时间轴
+    host_check(xanime_seek(anime, 10) == NULL, "spring seek rejected", 0);
+    host_check(xanime_reverse(anime) == NULL, "spring reverse rejected", 0);
+    xanime_delete(anime);
+}
+
+static void test_retarget(lv_obj_t *obj)
+{
+    static const xanime_spring_t follow = {.stiffness = 400, .damping = 40};
+    lv_obj_set_x(obj, 0);
+    start_num = complete_num = 0;
+    xanime_t *anime = xanime_create_single_rt(obj, (xanime_param_t){
+        .x = "200",
+        .spring = &follow,
+        .event_cb = event_cb,
+    });
+
+    xanime_start(anime);
+    host_run(100);
+    // 中途改变目标值，保留当前位置与速度，每帧的位移不会突变
+    int32_t prev = host_get_x(obj);
+    int32_t jump = 0;
+    xanime_retarget(anime, XANIME_PROP_X, XANIME_PX(-100));
+    for (int i = 0; i < 10; i++)
+    {
+        host_frame(HOST_FRAME_MS);
+        int32_t x = host_get_x(obj);
+        jump = LV_MAX(jump, LV_ABS(x - prev));
+        prev = x;
+    }
+    host_check(jump < 60, "retarget keeps position continuous", jump);
+    run_until_rest(anime, 5000);
+    host_check(host_get_x(obj) == -100, "retarget rests on new target", host_get_x(obj));
+    host_check(complete_num == 1, "retarget completes once", complete_num);
+
+    // 静止后改变目标值重新开始，相对值相对当前目标值
+    xanime_retarget(anime, XANIME_PROP_X, (xanime_value_t){.value = 50, .unit = XANIME_UNIT_REL});
+    host_check(anime->is_playing, "retarget wakes a rested spring", anime->is_playing);
+    run_until_rest(anime, 5000);
+    host_check(host_get_x(obj) == -50, "relative retarget", host_get_x(obj));
+    host_check(start_num == 2 && complete_num == 2, "restart emits start", start_num);
+    xanime_delete(anime);
+}
+
+static void test_inertia(lv_obj_t *obj)
+{
+    // 只有阻尼，速度按 e^(-damping × t) 衰减，总位移约为 v / damping
+    static const xanime_spring_t fling = {.damping = 4};
+    lv_obj_set_x(obj, 0);
+    xanime_t *anime = xanime_create_single_rt(obj, (xanime_param_t){
+        .x = "+=0",
+        .spring = &fling,
+    });
+    xanime_set_velocity(anime, XANIME_PROP_X, 800);
+    uint32_t t = run_until_rest(anime, 5000);
+    int32_t x = host_get_x(obj);
+    host_check(!anime->is_playing && t < 5000, "inertia stops", (long)t);
+    host_check(x > 150 && x <= 200, "inertia distance", x);
+    xanime_delete(anime);
+}
+
+static void test_overflow(lv_obj_t *obj)
+{
+    // 最大刚度与阻尼、最小质量，位移与初速度接近 INT32 范围
+    static const xanime_spring_t stiff = {.stiffness = UINT16_MAX, .damping = UINT16_MAX, .mass = 1};
+    lv_obj_set_x(obj, 0);
+    xanime_t *anime = xanime_create_single_rt(obj, (xanime_param_t){
+        .x = "2000000000",
+        .dur = "1000",
+        .spring = &stiff,
+    });
+    xanime_set_velocity(anime, XANIME_PROP_X, -2000000000);
+    xanime_start(anime);
+    host_run(300);
+    xanime_retarget(anime, XANIME_PROP_X, XANIME_PX(-2000000000));
+    run_until_rest(anime, 2000);
+    // 最长时长到达后结束
+    host_check(!anime->is_playing, "extreme spring ends by max duration", anime->is_playing);
+    xanime_delete(anime);
+}
+
+int main(void)
+{
+    host_init();
+    lv_obj_t *obj = lv_obj_create(lv_screen_active());
+    host_frame(HOST_FRAME_MS);
+
+    test_settle(obj);
+    test_retarget(obj);
+    test_inertia(obj);
+    test_overflow(obj);
+
+    lv_obj_delete(obj);
+    return host_result("spring");
+}
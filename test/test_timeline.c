@@ -0,0 +1,173 @@
+/********************************************************************************
+ * @description: 时间轴与组动画驱动测试
+ *   标签与偏移确定的开始时间，以及完成回调中删除控制器或时间轴时驱动遍历的安全性
+ *   (配合 -fsanitize=address 运行可以发现释放后使用)
+ ********************************************************************************/
+
+#include "host.h"
+#include "../xanime.c"
+
+static xanime_t *victim;
+static xanime_timeline_t *victim_tl;
+static int complete_num;
+static void *complete_var;
+
+static void complete_cb(lv_anim_t *a)
+{
+    complete_num++;
+    complete_var = a->var;
+}
+
+// 删除另一个控制器
+static void delete_anime_cb(lv_anim_t *a)
+{
+    complete_num++;
+    if (victim)
+    {
+        xanime_delete(victim);
+        victim = NULL;
+    }
+}
+
+// 删除正在播放的时间轴
+static void delete_timeline_cb(lv_anim_t *a)
+{
+    complete_num++;
+    if (victim_tl)
+    {
+        xanime_timeline_delete(victim_tl);
+        victim_tl = NULL;
+    }
+}
+
+static xanime_t *group_rt(lv_obj_t **objs, uint16_t num, char *x, char *dur, lv_anim_ready_cb_t cb)
+{
+    return xanime_create_rt((xanime_obj_t){.obj_num = num, .obj_arr = objs}, (xanime_param_t){
+        .x = x,
+        .dur = dur,
+        .mode = XANIME_MODE_GROUP,
+        .complete_cb = cb,
+    });
+}
+
+static void test_offsets(lv_obj_t *scr)
+{
+    lv_obj_t *objs[3];
+    for (int i = 0; i < 3; i++)
+        objs[i] = lv_obj_create(scr);
+
+    xanime_t *first = group_rt(&objs[0], 1, "300", "300", NULL);
+    xanime_t *second = group_rt(&objs[1], 1, "200", "200", NULL);
+    xanime_t *third = group_rt(&objs[2], 1, "100", "100", NULL);
+
+    xanime_timeline_t *tl = xanime_timeline_create();
+    xanime_timeline_add(tl, first, NULL);
+    xanime_timeline_add_label(tl, "ready", NULL);
+    xanime_timeline_add(tl, second, "ready+=100");
+    xanime_timeline_add(tl, third, "<");
+    xanime_delete(first);
+    xanime_delete(second);
+    xanime_delete(third);
+
+    host_check(xanime_timeline_get_duration(tl) == 600, "timeline duration", (long)xanime_timeline_get_duration(tl));
+
+    // 开始前的帧处理掉启动时的布局刷新
+    host_frame(HOST_FRAME_MS);
+    xanime_timeline_start(tl);
+    host_run(150);
+    int32_t x = host_get_x(objs[0]);
+    host_check(x > 100 && x < 200, "first at 150ms", x);
+    host_check(host_get_x(objs[1]) == 0, "second before its offset", host_get_x(objs[1]));
+    host_check(host_get_x(objs[2]) == 0, "third before its offset", host_get_x(objs[2]));
+
+    // 400ms 后 "<" 与上一个同时开始
+    host_run(350);
+    x = host_get_x(objs[1]);
+    host_check(x > 0 && x < 200, "second after its offset", x);
+    host_check(host_get_x(objs[0]) == 300, "first finished", host_get_x(objs[0]));
+    host_check(host_get_x(objs[2]) == 100, "third finished with second's start", host_get_x(objs[2]));
+
+    host_run(200);
+    host_check(host_get_x(objs[1]) == 200, "second finished", host_get_x(objs[1]));
+    host_check(driver.head == NULL, "driver idle after timeline", 0);
+
+    xanime_timeline_delete(tl);
+    for (int i = 0; i < 3; i++)
+        lv_obj_delete(objs[i]);
+}
+
+static void test_complete_var(lv_obj_t *scr)
+{
+    lv_obj_t *objs[2] = {lv_obj_create(scr), lv_obj_create(scr)};
+    lv_obj_t *second = objs[1];
+    xanime_t *anime = group_rt(objs, 2, "100", "200", complete_cb);
+
+    complete_num = 0;
+    xanime_start(anime);
+    host_run(100);
+    // 第一个对象删除后回调收到仍然存在的对象
+    lv_obj_delete(objs[0]);
+    host_run(200);
+    host_check(complete_num == 1, "complete after first object deleted", complete_num);
+    host_check(complete_var == second, "complete var is a live object", 0);
+
+    xanime_delete(anime);
+    lv_obj_delete(second);
+}
+
+static void test_reentrancy(lv_obj_t *scr)
+{
+    lv_obj_t *objs[4];
+    for (int i = 0; i < 4; i++)
+        objs[i] = lv_obj_create(scr);
+
+    // 完成回调删除链表中的下一个节点 (后启动的节点在链表前面)
+    complete_num = 0;
+    xanime_t *killer = group_rt(&objs[0], 1, "100", "100", delete_anime_cb);
+    xanime_start(killer);
+    victim = group_rt(&objs[1], 1, "100", "1000", NULL);
+    xanime_start(victim);
+    host_run(200);
+    host_check(complete_num == 1 && victim == NULL, "delete running node from callback", complete_num);
+    xanime_delete(killer);
+
+    // 同一帧结束的两个节点，第一个的回调删除另一个，另一个不再回调
+    complete_num = 0;
+    xanime_t *a = group_rt(&objs[2], 1, "100", "100", delete_anime_cb);
+    xanime_t *b = group_rt(&objs[3], 1, "100", "100", delete_anime_cb);
+    xanime_start(a);
+    xanime_start(b);
+    victim = a;
+    host_run(200);
+    host_check(complete_num == 1, "delete finished node from callback", complete_num);
+    xanime_delete(b);
+
+    // 子动画的完成回调删除时间轴
+    complete_num = 0;
+    xanime_t *c1 = group_rt(&objs[0], 1, "50", "100", delete_timeline_cb);
+    xanime_t *c2 = group_rt(&objs[1], 1, "50", "100", delete_timeline_cb);
+    victim_tl = xanime_timeline_create();
+    xanime_timeline_add(victim_tl, c1, NULL);
+    xanime_timeline_add(victim_tl, c2, "<");
+    xanime_timeline_add(victim_tl, c2, ">");
+    xanime_delete(c1);
+    xanime_delete(c2);
+    xanime_timeline_start(victim_tl);
+    host_run(300);
+    host_check(complete_num == 1 && victim_tl == NULL, "delete timeline from child callback", complete_num);
+    host_check(driver.head == NULL, "driver idle after timeline deleted", 0);
+
+    for (int i = 0; i < 4; i++)
+        lv_obj_delete(objs[i]);
+}
+
+int main(void)
+{
+    host_init();
+    lv_obj_t *scr = lv_screen_active();
+
+    test_offsets(scr);
+    test_complete_var(scr);
+    test_reentrancy(scr);
+    return host_result("timeline");
+}
@@ -14,810 +14,6527 @@
 #include <stdlib.h>
 #include <string.h>
 
+// 批量插值的 SIMD 实现，按编译目标选择
+#if XANIME_USE_SIMD && defined(__AVX2__)
+#define LERP_AVX2 1
+#include <immintrin.h>
+#elif XANIME_USE_SIMD && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define LERP_SSE2 1
+#include <emmintrin.h>
+#elif XANIME_USE_SIMD && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define LERP_NEON 1
+#include <arm_neon.h>
+#endif
+
+// 堆分配
+#ifndef XANIME_MALLOC
+#if XANIME_USE_LV_MALLOC
+#define XANIME_MALLOC lv_malloc
+#define XANIME_REALLOC lv_realloc
+#define XANIME_FREE lv_free
+#else
+#define XANIME_MALLOC malloc
+#define XANIME_REALLOC realloc
+#define XANIME_FREE free
+#endif
+#endif
+
+static void *pool_alloc(xanime_pool_id_t id, size_t size);
+
+static void pool_free(xanime_pool_id_t id, void *ptr);
+
+static xanime_handle_t handle_register(xanime_t *anime);
+
+static void handle_release(xanime_handle_t handle);
+
+static void anime_emit(xanime_t *anime, xanime_event_t event);
+
+static void event_timer_cb(lv_timer_t *timer);
+
+static void event_queue_drop(xanime_t *anime);
+
 static lv_anim_path_cb_t get_easing_func(xanime_easing_t easing);
 
+static uint8_t ease_normalize(xanime_easing_t easing);
+
+static int32_t ease_eval(uint32_t easing, int32_t t);
+
 static int32_t str_to_int32(const char *str, bool *success);
 
-static int int32_to_str(int32_t value, char *buffer, size_t bufsize);
+static bool parse_value(const char *str, xanime_value_t *out);
+
+bool check_param(const char *param);
 
 static void zoom_exec_cb(void *var, int32_t v);
 
+static void bg_color_exec_cb(void *var, int32_t v);
+
+static void border_color_exec_cb(void *var, int32_t v);
+
+static void text_color_exec_cb(void *var, int32_t v);
+
+static void border_width_exec_cb(void *var, int32_t v);
+
+static void shadow_width_exec_cb(void *var, int32_t v);
+
+static void letter_space_exec_cb(void *var, int32_t v);
+
+static int32_t x_get(lv_obj_t *obj);
+
+static int32_t y_get(lv_obj_t *obj);
+
+static int32_t width_get(lv_obj_t *obj);
+
+static int32_t height_get(lv_obj_t *obj);
+
+static int32_t opa_get(lv_obj_t *obj);
+
+static int32_t rotate_get(lv_obj_t *obj);
+
+static int32_t scale_get(lv_obj_t *obj);
+
+static int32_t bg_color_get(lv_obj_t *obj);
+
+static int32_t border_color_get(lv_obj_t *obj);
+
+static int32_t text_color_get(lv_obj_t *obj);
+
+static int32_t border_width_get(lv_obj_t *obj);
+
+static int32_t shadow_width_get(lv_obj_t *obj);
+
+static int32_t translate_x_get(lv_obj_t *obj);
+
+static int32_t translate_y_get(lv_obj_t *obj);
+
+static int32_t letter_space_get(lv_obj_t *obj);
+
+static bool parse_color(const char *str, xanime_value_t *out);
+
+static const char *prop_name(uint8_t prop);
+
+static bool prop_percent_ok(uint8_t prop);
+
+static uint8_t mask_pop(uint32_t *mask);
+
 static void opa_exec_cb(void *var, int32_t v);
 
 static void rotate_exec_cb(void *var, int32_t v);
 
+static void translate_x_exec_cb(void *var, int32_t v);
+
+static void translate_y_exec_cb(void *var, int32_t v);
+
+static void flip_width_exec_cb(void *var, int32_t v);
+
+static void flip_height_exec_cb(void *var, int32_t v);
+
 static bool is_image_object(lv_obj_t *obj);
 
-static int16_t get_x_percent(lv_obj_t *obj, char *percent);
+// 启动时的几何快照，所有百分比解析共用，同一父对象的内容尺寸只读取一次
+typedef struct
+{
+    lv_obj_t *parent;
+    int32_t parent_w;
+    int32_t parent_h;
+    int32_t obj_w;
+    int32_t obj_h;
+} geom_snapshot_t;
+
+static void refresh_layout(xanime_t *anime);
+
+static bool spec_needs_geom(const xanime_spec_t *spec);
+
+static void geom_snapshot(geom_snapshot_t *geom, lv_obj_t *obj);
+
+static int32_t get_x_percent(const geom_snapshot_t *geom, int32_t percent);
+
+static int32_t get_y_percent(const geom_snapshot_t *geom, int32_t percent);
+
+static int32_t get_width_percent(const geom_snapshot_t *geom, int32_t percent);
+
+static int32_t get_height_percent(const geom_snapshot_t *geom, int32_t percent);
+
+static int32_t resolve_value(xanime_prop_t prop, const geom_snapshot_t *geom, xanime_value_t value, int32_t cur);
+
+static xanime_t *anime_alloc(xanime_obj_t obj, const xanime_spec_t *spec);
+
+// 进度精度，融合动画的 lv_anim 在 [0, XANIME_PROGRESS_MAX] 之间运行
+#define XANIME_PROGRESS_SHIFT 10
+#define XANIME_PROGRESS_MAX (1 << XANIME_PROGRESS_SHIFT)
+
+// 时间缩放精度，XANIME_TIMESCALE_NORMAL == 1 << XANIME_TIMESCALE_SHIFT
+#define XANIME_TIMESCALE_SHIFT 8
+
+// 弹簧位置与速度的小数位数，以及卡顿后每次最多追赶的积分时间 (ms)
+#define SPRING_SHIFT 16
+// 定点数的 1.0，负数用乘法转换 (负数左移是未定义行为)
+#define SPRING_ONE ((int64_t)1 << SPRING_SHIFT)
+#define SPRING_CATCH_UP 100
+// 积分中位移、速度与加速度的上限 (约 2^30 个单位)，刚度与阻尼不超过 2^16 时乘积之和不会溢出 int64
+#define SPRING_LIMIT ((int64_t)1 << 46)
+
+// 可动画的属性数量 (pivot 只在启动时设置一次)
+#define ANIM_PROP_COUNT XANIME_PROP_ANIM_COUNT
+
+// 属性位图与错误位共用 32 位，属性不能超过 XANIME_ERR_PATH 之前的 26 位
+#if XANIME_CHANNEL_CUSTOM_NUM > 9
+#error "XANIME_CHANNEL_CUSTOM_NUM must not exceed 9"
+#endif
+
+// 单个属性通道
+typedef struct
+{
+    lv_anim_exec_xcb_t exec_cb;
+    int32_t start;
+    int32_t end;
+    uint8_t prop;
+} anim_channel_t;
+
+// 控制器启动的 lv_anim，动画被删除时清空
+typedef struct _xanime_slot_t
+{
+    xanime_t *owner;
+    lv_anim_t *anim;
+} anim_slot_t;
+
+// 控制器的运行状态，与公开的 xanime_t 一次分配，对象数组与 lv_anim 记录紧随其后
+typedef struct
+{
+    xanime_t pub;
+    // 已解析的组动画，播放控制与重新播放直接复用
+    struct _xanime_group_t *runner;
+    // 运动路径的弧长查找表，第一次启动时构建，重新播放直接复用
+    struct _xanime_path_lut_t *path_lut;
+    // 已启动的 lv_anim 记录，删除控制器时取消
+    anim_slot_t *slots;
+    uint32_t slot_num;
+    // 已使用的记录与仍在运行的 lv_anim 数量
+    uint32_t slot_used;
+    uint32_t slot_live;
+    // 句柄，删除后失效
+    xanime_handle_t handle;
+    // 数值未变化而跳过的写入次数
+    uint32_t skip_cnt;
+    // 已派发重复事件的轮数 (融合模式) 与队列中是否已有更新事件
+    uint16_t event_round;
+    bool update_queued;
+} anime_priv_t;
+
+#define ANIME_PRIV(anime) ((anime_priv_t *)(anime))
+
+// 覆盖索引中的一项，记录对象的一个属性由哪个动画驱动
+typedef struct _claim_t
+{
+    struct _claim_t *next;
+    lv_obj_t *obj;
+    // 所属的组动画或融合动画
+    void *runner;
+    uint8_t prop;
+    bool is_group;
+    // 未被覆盖，动画继续写入该属性
+    bool live;
+} claim_t;
+
+// 按 (对象, 属性) 散列的覆盖索引，项数超过桶数的两倍时扩容
+typedef struct
+{
+    claim_t **buckets;
+    uint32_t size;
+    uint32_t count;
+} claim_index_t;
+
+static claim_index_t claim_index;
+
+static claim_t **claim_bucket(const lv_obj_t *obj, uint8_t prop);
+
+static void claim_insert(claim_t *claim);
+
+static void claim_remove(claim_t *claim);
+
+static void claim_kill(claim_t *claim);
+
+static bool claim_owned(const claim_t *claim, const xanime_t *anime);
+
+static void overwrite_conflicts(xanime_t *anime);
+
+// 快照与旋转帧都用代理图片代替对象显示
+#define PROXY_ENABLE (LV_USE_SNAPSHOT || LV_USE_CANVAS)
+
+// 预渲染的旋转帧，帧的中心为图片的旋转中心
+typedef struct _sprite_t
+{
+    struct _sprite_t *next;
+    const void *src;
+    lv_point_t pivot;
+    // 帧边长的一半
+    int32_t radius;
+    uint8_t frame_num;
+    uint16_t ref_cnt;
+    // 计入内存预算的字节数
+    uint32_t size;
+    lv_draw_buf_t **frames;
+} sprite_t;
+
+// 快照动画，播放中用快照图片 (或旋转帧) 代替对象，对象保持透明
+typedef struct
+{
+    // 原对象，被删除时为 NULL
+    lv_obj_t *obj;
+    // 显示快照的图片，没有快照时为 NULL
+    lv_obj_t *proxy;
+    lv_draw_buf_t *buf;
+    // 计入内存预算的字节数
+    uint32_t size;
+    // 使用旋转帧时的帧表与当前角度
+    sprite_t *sprite;
+    int32_t angle;
+} snapshot_t;
+
+static bool spec_snapshot(const xanime_spec_t *spec);
+
+static lv_obj_t *snapshot_begin(snapshot_t *snap, lv_obj_t *obj, bool bitmap, uint8_t sprite_frames);
+
+#if LV_USE_SNAPSHOT
+static lv_obj_t *snapshot_render(snapshot_t *snap, lv_obj_t *obj);
+#endif
+
+#if LV_USE_CANVAS
+static lv_obj_t *sprite_begin(snapshot_t *snap, lv_obj_t *obj, uint8_t frame_num);
+
+static sprite_t *sprite_get(const void *src, int32_t w, int32_t h, lv_point_t pivot, uint8_t frame_num);
+
+static void sprite_put(sprite_t *sp);
+
+static void sprite_exec_cb(void *var, int32_t v);
+#endif
+
+static void snapshot_end(snapshot_t *snap);
+
+static void snapshot_obj_delete_cb(lv_event_t *e);
+
+// 运动路径输出的分量
+typedef enum
+{
+    PATH_AXIS_X,
+    PATH_AXIS_Y,
+    PATH_AXIS_ANGLE,
+    PATH_AXIS_NUM,
+    // 不由路径驱动的通道
+    PATH_AXIS_NONE = PATH_AXIS_NUM,
+} path_axis_t;
+
+// 运动路径的弧长查找表，路径展开为折线后按弧长均分，每帧求值为常数时间
+typedef struct _xanime_path_lut_t
+{
+    // 控制器、组动画与每个融合动画各持有一次
+    uint16_t refs;
+    uint16_t piece_num;
+    // 总弧长 (1/16 像素)
+    uint32_t length;
+    // 展开后的顶点 (1/16 像素) 与顶点到起点的弧长，各 piece_num + 1 个
+    int32_t *xs;
+    int32_t *ys;
+    uint32_t *dist;
+    // 每段起点与终点的切线角度 (0.1 度)，贝塞尔曲线在段内插值
+    int16_t *angles;
+    // 弧长均分后每份起点所在的段
+    uint16_t bucket[XANIME_PATH_LUT_SIZE + 1];
+    bool relative;
+    // 反向播放时从终点走向起点
+    bool reverse;
+    int16_t rotate_offset;
+    // 上次求值的进度与结果，同一帧内各通道与对象共用
+    int32_t cache_progress;
+    int32_t cache_value[PATH_AXIS_NUM];
+} path_lut_t;
+
+static path_lut_t *path_lut_build(const xanime_spec_t *spec);
+
+static path_lut_t *path_lut_ref(path_lut_t *lut);
+
+static void path_lut_put(path_lut_t *lut);
+
+static int32_t path_value(path_lut_t *lut, uint8_t axis, int32_t progress, int32_t origin);
+
+static uint8_t path_axis(const xanime_spec_t *spec, uint8_t prop);
+
+static void path_eval(path_lut_t *lut, int32_t progress);
+
+static int32_t path_atan2(int64_t dy, int64_t dx);
+
+// 融合动画，每个对象一份通道表，起止值分开存放用于批量插值
+typedef struct
+{
+    // 所属控制器的记录，自动播放的动画为 NULL
+    anim_slot_t *slot;
+    lv_anim_ready_cb_t complete_cb;
+    void *user_data;
+    uint8_t ch_num;
+    // 存在超出 32 位批量插值范围的通道
+    bool wide;
+    // last 中已有写入过的值
+    bool cached;
+    uint8_t threshold;
+    // 可以剔除不可见对象，culled 为最近一次检测的结果
+    bool cullable;
+    bool culled;
+    uint32_t cull_tick;
+    // 优先级与降频时的帧计数
+    uint8_t priority;
+    uint8_t sched_cnt;
+    // 限制帧率时的最小写入间隔 (ms) 与上次写入的 tick
+    uint16_t interval;
+    uint32_t write_tick;
+    // 启动的 lv_anim，覆盖时按它删除
+    lv_anim_t *anim;
+    // 已重复的轮数与上一帧的 act_time，act_time 回退时为新的一轮
+    uint16_t round;
+    int32_t act_last;
+    // 每个通道在覆盖索引中的记录，不参与覆盖时为 NULL
+    claim_t *claims;
+    uint8_t claim_live;
+    // 颜色通道的位图 (按通道序号)，按分量插值
+    uint32_t color_mask;
+    // 运动路径与路径驱动的 x / y / 旋转通道的序号，没有时为 UINT8_MAX
+    path_lut_t *path;
+    uint8_t path_ch[PATH_AXIS_NUM];
+    snapshot_t snap;
+    // 通道数据按 ch_num 分配在结构体之后，只包含设置了的通道
+    lv_anim_exec_xcb_t *exec_cb;
+    int32_t *start;
+    int32_t *end;
+    // 上次写入对象的值
+    int32_t *last;
+} fused_anim_t;
+
+// 批量插值使用 32 位乘法，起止差值不超过该值时结果不会溢出 (缓动进度的绝对值小于 2^16)
+#define LERP_NARROW_MAX 32767
+
+static void lerp_batch(const int32_t *from, const int32_t *to, int32_t *out, uint32_t n, int32_t progress);
+
+static void lerp_batch_wide(const int32_t *from, const int32_t *to, int32_t *out, uint32_t n, int32_t progress);
+
+static bool lerp_is_narrow(int32_t from, int32_t to);
+
+static int32_t lerp_color(int32_t from, int32_t to, int32_t progress);
+
+static void lerp_color_batch(const int32_t *from, const int32_t *to, int32_t *out, uint32_t n, int32_t progress);
+
+static bool write_skippable(int32_t last, int32_t v, bool at_key, uint8_t threshold);
+
+static bool spec_cullable(const xanime_spec_t *spec);
+
+static bool obj_culled(lv_obj_t *obj);
+
+static bool cull_due(uint32_t cull_tick);
+
+static void param_handle(lv_anim_t *anim, xanime_t *anime, lv_obj_t *obj, const geom_snapshot_t *geom,
+                         uint32_t delay);
+
+static void anim_property_start(xanime_t *anime, lv_anim_t *anim, lv_anim_exec_xcb_t exec_cb, int32_t start,
+                                int32_t end);
+
+static uint8_t resolve_channels(xanime_t *anime, lv_obj_t *obj, const geom_snapshot_t *geom, anim_channel_t *ch);
+
+static bool prop_is_position(uint8_t prop);
+
+static int32_t translate_commit(lv_obj_t *obj, uint8_t prop, int32_t end, int32_t cur);
+
+static void translate_channel(lv_obj_t *obj, uint8_t prop, bool is_from, anim_channel_t *ch);
+
+static bool spec_flip_size(const xanime_spec_t *spec);
+
+static bool prop_is_size(uint8_t prop);
+
+static void flip_commit(lv_obj_t *obj, uint8_t prop, int32_t size);
+
+static void flip_channel(lv_obj_t *obj, uint8_t prop, bool is_from, anim_channel_t *ch);
+
+static void apply_pivot(xanime_t *anime, lv_obj_t *obj, const geom_snapshot_t *geom);
+
+static int32_t prop_get_value(uint8_t prop, lv_obj_t *obj);
+
+static bool prop_is_color(uint8_t prop);
+
+static lv_anim_exec_xcb_t prop_exec_cb(uint8_t prop);
+
+static void fused_start(lv_anim_t *anim, xanime_t *anime, const anim_channel_t *ch, uint8_t ch_num);
+
+static void fused_exec_cb(lv_anim_t *a, int32_t v);
+
+static void fused_ready_cb(lv_anim_t *a);
 
-static int16_t get_y_percent(lv_obj_t *obj, char *percent);
+static void fused_deleted_cb(lv_anim_t *a);
 
-static int16_t get_width_percent(lv_obj_t *obj, char *percent);
+static uint32_t anime_slot_count(const xanime_spec_t *spec, uint16_t obj_num);
+
+static anim_slot_t *anime_slot_take(xanime_t *anime);
+
+static void anime_slot_bind(anim_slot_t *slot, lv_anim_t *anim);
+
+static void anime_slot_release(anim_slot_t *slot);
+
+static void anime_slot_ready_cb(lv_anim_t *a);
+
+static void anime_slot_deleted_cb(lv_anim_t *a);
+
+static void anime_cancel(xanime_t *anime);
+
+static void anime_obj_delete_cb(lv_event_t *e);
+
+// 驱动节点，组动画与时间轴共用一个驱动
+typedef struct _driver_node_t
+{
+    struct _driver_node_t *next;
+    // 推进时钟，结束时返回 true
+    bool (*advance)(struct _driver_node_t *node, uint32_t now);
+    // 结束并从驱动移除后调用
+    void (*finish)(struct _driver_node_t *node);
+    // 上次推进时的 tick
+    uint32_t last_tick;
+    // 优先级与降频时错开更新帧的相位
+    uint8_t priority;
+    uint8_t phase;
+    // 限制帧率时的最小更新间隔 (ms)，0 表示每个驱动周期都更新
+    uint16_t interval;
+    // 可选，返回节点确定不需要更新的时间 (ms)，用于延长驱动周期
+    uint32_t (*idle)(const struct _driver_node_t *node);
+} driver_node_t;
+
+// 组动画中的单个通道，关键帧的值按 [关键帧][对象] 连续存放
+typedef struct
+{
+    lv_anim_exec_xcb_t exec_cb;
+    uint8_t prop;
+    uint16_t kf_num;
+    // 存在超出 32 位批量插值范围的段
+    bool wide;
+    // 颜色通道，按分量插值
+    bool color;
+    // 由运动路径驱动的分量 (path_axis_t)
+    uint8_t path_axis;
+    // 位置通道使用 translate 样式，关键帧值在开始时转换为偏移
+    bool translate;
+    // 尺寸通道使用缩放变换，flip_key 为已提交真实尺寸的关键帧
+    bool flip;
+    uint16_t flip_key;
+    // 缓存的当前段，段 seg 为关键帧 seg 到 seg + 1
+    uint16_t seg;
+    uint32_t *times;
+    // easings[k] 为到达关键帧 k 的缓动
+    uint8_t *easings;
+    // rel[k] 非 0 时关键帧 k 的值为相对当前值的增量，在动画开始时确定
+    uint8_t *rel;
+    int32_t *values;
+    // 每个对象上次写入的值
+    int32_t *last;
+} group_channel_t;
+
+// 组动画，整个控制器共用一个时钟
+typedef struct _xanime_group_t
+{
+    driver_node_t node;
+    lv_obj_t **objs;
+    uint16_t obj_num;
+    // 尚未删除的对象数量
+    uint16_t obj_live;
+    uint8_t ch_num;
+    // 已读取开始时的当前值
+    bool captured;
+    bool is_from;
+    group_channel_t *ch;
+    // 每个对象的快照，不使用快照时为 NULL
+    snapshot_t *snaps;
+    bool snap_bitmap;
+    uint8_t sprite_frames;
+    // 批量插值的输出，每个对象一个
+    int32_t *scratch;
+    // 时间状态
+    uint32_t dur;
+    uint32_t delay;
+    uint32_t elapsed;
+    uint32_t loop_idx;
+    // 每个对象相对 delay 的开始时间，不错开时为 NULL；stagger 为其中的最大值
+    uint32_t *offsets;
+    uint32_t stagger;
+    // 总播放次数，LV_ANIM_REPEAT_INFINITE 表示无限循环
+    uint32_t repeat_cnt;
+    // 时间缩放 (XANIME_TIMESCALE_NORMAL 为 1 倍速) 与累积的余数
+    uint16_t timescale;
+    uint16_t time_frac;
+    bool reversed;
+    // 已注册到驱动
+    bool active;
+    // 通道的 last 中已有写入过的值
+    bool cached;
+    uint8_t threshold;
+    // 每个对象最近一次的可见性检测结果，不剔除时为 NULL；culling 为 true 时跳过不可见对象
+    uint8_t *culled;
+    uint16_t cull_num;
+    bool culling;
+    uint32_t cull_tick;
+    // 覆盖索引中的记录，按 [通道][对象] 存放，不参与覆盖时为 NULL；所有属性都被覆盖后 killed 为 true
+    claim_t *claims;
+    uint32_t claim_live;
+    bool killed;
+    // 运动路径，没有时为 NULL
+    path_lut_t *path;
+    // 弹簧状态，不使用弹簧时为 NULL；按 [通道][对象] 存放，位置与速度 (每秒) 带 16 位小数
+    int64_t *spring_pos;
+    int64_t *spring_vel;
+    xanime_spring_t spring;
+    // 积分步长 (ms)、相对延迟结束已积分的时间与最近一次改变目标的时间
+    uint8_t spring_step;
+    uint32_t spring_time;
+    uint32_t spring_base;
+    // 所属的控制器，为 NULL 时结束后自动释放
+    xanime_t *owner;
+    lv_anim_ready_cb_t complete_cb;
+    void *user_data;
+} group_anim_t;
+
+// 组动画驱动，所有组动画与时间轴共用一个定时器
+typedef struct
+{
+    lv_timer_t *timer;
+    driver_node_t *head;
+    // 遍历中下一个要推进的节点与本帧结束、等待调用 finish 的节点，回调中删除的节点从中移除
+    driver_node_t *next;
+    driver_node_t *finished;
+    // 驱动的帧计数与下一个节点的相位
+    uint32_t frame;
+    uint8_t phase_seq;
+    // 负载等级 (0 - XANIME_LOAD_MAX)，调整后保持的帧数
+    uint8_t level;
+    uint8_t hold;
+    // 每帧开销的平滑值 (1/16 ms)
+    uint32_t cost;
+    // 本帧渲染开始的 tick 与驱动更新累计的时间 (ms)
+    uint32_t refr_start;
+    uint32_t update_ms;
+    // 已注册刷新事件的显示器
+    lv_display_t *disp;
+    // 定时器当前的周期与上次运行的 tick
+    uint32_t period;
+    uint32_t run_tick;
+} group_driver_t;
+
+static group_driver_t driver;
+
+static void sched_attach(void);
+
+static void sched_refr_cb(lv_event_t *e);
+
+static uint32_t sched_divider(uint8_t priority);
+
+static uint16_t fps_interval(uint8_t fps);
+
+static void driver_reschedule(uint32_t now);
+
+static void driver_wake(void);
+
+// 控制器事件，控制器删除时其中的记录置为 NULL，不受句柄表大小限制
+typedef struct
+{
+    xanime_t *anime;
+    uint8_t event;
+} event_entry_t;
+
+// 事件环形队列，由定时器在动画定时器之后派发，队列为空时定时器暂停
+typedef struct
+{
+    event_entry_t *items;
+    uint16_t size;
+    uint16_t head;
+    uint16_t count;
+    lv_timer_t *timer;
+} event_queue_t;
+
+static event_queue_t event_queue;
+
+// 时间轴中的子动画
+typedef struct
+{
+    group_anim_t *runner;
+    // 在时间轴上的开始时间
+    uint32_t offset;
+    // 子动画总时长，包含延迟与循环
+    uint32_t span;
+    bool started;
+    bool finished;
+} timeline_child_t;
+
+// 时间轴标签
+typedef struct
+{
+    char name[XANIME_TIMELINE_LABEL_LEN];
+    uint32_t time;
+} timeline_label_t;
+
+struct _xanime_timeline_t
+{
+    driver_node_t node;
+    timeline_child_t *children;
+    uint16_t child_num;
+    uint16_t child_cap;
+    timeline_label_t *labels;
+    uint16_t label_num;
+    uint16_t label_cap;
+    // 上一个子动画的开始与结束时间，用于 "<" 和 ">" 定位
+    uint32_t prev_start;
+    uint32_t prev_end;
+    uint32_t duration;
+    uint32_t elapsed;
+    bool is_playing;
+    // 正在推进子动画，期间子动画完成回调中的删除推迟到推进结束后
+    bool in_render;
+    bool delete_pending;
+    lv_anim_ready_cb_t complete_cb;
+    void *user_data;
+};
+
+static bool spec_has_tracks(const xanime_spec_t *spec);
+
+static bool spec_grouped(const xanime_spec_t *spec);
+
+static void spec_resolve_mode(xanime_spec_t *spec);
+
+static const xanime_track_t *spec_track(const xanime_spec_t *spec, uint8_t prop);
+
+static uint8_t spring_step(const xanime_spring_t *spring);
+
+static void group_spring_reset(group_anim_t *g);
+
+static bool group_update_spring(group_anim_t *g);
+
+static int64_t spring_clamp(int64_t v, int64_t limit);
+
+static void group_spring_integrate(group_anim_t *g);
+
+static bool group_spring_settled(const group_anim_t *g);
+
+static void group_channel_apply_spring(group_anim_t *g, uint8_t c);
+
+static group_anim_t *spring_runner(xanime_t *anime, xanime_prop_t prop, group_channel_t **ch);
+
+static void spring_wake(xanime_t *anime, group_anim_t *g);
+
+static uint16_t track_kf_num(const xanime_track_t *track);
+
+static const xanime_keyframe_t *track_frame(const xanime_track_t *track, uint16_t k);
+
+static group_anim_t *group_start(xanime_t *anime, bool need_geom);
+
+static void group_play(group_anim_t *g);
+
+static void group_stop(group_anim_t *g);
+
+static void group_snapshot(group_anim_t *g, bool begin);
+
+static group_anim_t *anime_runner(xanime_t *anime);
+
+static xanime_t *anime_start(xanime_t *anime, bool detached);
+
+static group_anim_t *group_build(xanime_t *anime, bool need_geom);
+
+static bool group_cull(group_anim_t *g);
+
+static uint32_t group_idle(const driver_node_t *node);
+
+static void group_claim(group_anim_t *g);
+
+static void group_unclaim(group_anim_t *g);
+
+static void group_capture(group_anim_t *g);
+
+static void group_translate_channel(group_anim_t *g, group_channel_t *ch);
+
+static bool group_update(group_anim_t *g);
+
+static void group_seek(group_anim_t *g, uint32_t t);
+
+static void group_channel_apply(group_anim_t *g, group_channel_t *ch, uint32_t t);
+
+static bool group_update_stagger(group_anim_t *g, uint32_t t);
+
+static void group_channel_apply_stagger(group_anim_t *g, group_channel_t *ch, uint32_t t);
+
+static void group_exec(group_anim_t *g, uint16_t i, lv_anim_exec_xcb_t exec_cb, int32_t value);
+
+static int32_t segment_progress(const group_channel_t *ch, uint16_t seg, uint32_t t);
+
+static uint16_t find_segment(const uint32_t *times, uint16_t kf_num, uint32_t t);
+
+static int32_t ease_progress(uint8_t easing, uint32_t t, uint32_t dur);
+
+static uint32_t group_span(const group_anim_t *g);
+
+static uint32_t isqrt64(uint64_t v);
+
+static uint32_t stagger_dist(const xanime_spec_t *spec, uint32_t idx, uint32_t num);
+
+static uint32_t stagger_offset(const xanime_spec_t *spec, uint16_t idx, uint16_t num);
+
+static void group_notify_complete(group_anim_t *g);
+
+static bool group_advance(driver_node_t *node, uint32_t now);
+
+static void group_finish(driver_node_t *node);
+
+static void group_free(group_anim_t *g);
+
+static void group_obj_delete_cb(lv_event_t *e);
+
+static void driver_add(driver_node_t *node);
+
+static void driver_remove(driver_node_t *node);
+
+static void driver_timer_cb(lv_timer_t *timer);
+
+static bool timeline_position(xanime_timeline_t *tl, const char *position, uint32_t *time);
+
+static bool timeline_render(xanime_timeline_t *tl);
+
+static bool timeline_advance(driver_node_t *node, uint32_t now);
+
+static void timeline_finish(driver_node_t *node);
+
+static void timeline_free(xanime_timeline_t *tl);
+
+// 通道注册表，按属性索引存放，自定义通道注册前 set 为 NULL
+static xanime_channel_t channel_table[ANIM_PROP_COUNT] = {
+    [XANIME_PROP_X] = {"x", x_get, (lv_anim_exec_xcb_t)lv_obj_set_x, XANIME_VALUE_INT, XANIME_INVALIDATE_LAYOUT, 0},
+    [XANIME_PROP_Y] = {"y", y_get, (lv_anim_exec_xcb_t)lv_obj_set_y, XANIME_VALUE_INT, XANIME_INVALIDATE_LAYOUT, 0},
+    [XANIME_PROP_WIDTH] = {"width", width_get, (lv_anim_exec_xcb_t)lv_obj_set_width, XANIME_VALUE_INT,
+                           XANIME_INVALIDATE_LAYOUT, 0},
+    [XANIME_PROP_HEIGHT] = {"height", height_get, (lv_anim_exec_xcb_t)lv_obj_set_height, XANIME_VALUE_INT,
+                            XANIME_INVALIDATE_LAYOUT, 0},
+    [XANIME_PROP_OPACITY] = {"opacity", opa_get, opa_exec_cb, XANIME_VALUE_INT, XANIME_INVALIDATE_TRANSFORM,
+                             LV_OPA_COVER},
+    [XANIME_PROP_ROTATE] = {"rotate", rotate_get, rotate_exec_cb, XANIME_VALUE_INT, XANIME_INVALIDATE_TRANSFORM, 0},
+    [XANIME_PROP_SCALE] = {"scale", scale_get, zoom_exec_cb, XANIME_VALUE_INT, XANIME_INVALIDATE_TRANSFORM,
+                           LV_SCALE_NONE},
+    [XANIME_PROP_BG_COLOR] = {"bg_color", bg_color_get, bg_color_exec_cb, XANIME_VALUE_COLOR,
+                              XANIME_INVALIDATE_REDRAW, 0},
+    [XANIME_PROP_BORDER_COLOR] = {"border_color", border_color_get, border_color_exec_cb, XANIME_VALUE_COLOR,
+                                  XANIME_INVALIDATE_REDRAW, 0},
+    [XANIME_PROP_TEXT_COLOR] = {"text_color", text_color_get, text_color_exec_cb, XANIME_VALUE_COLOR,
+                                XANIME_INVALIDATE_REDRAW, 0},
+    [XANIME_PROP_BORDER_WIDTH] = {"border_width", border_width_get, border_width_exec_cb, XANIME_VALUE_INT,
+                                  XANIME_INVALIDATE_REDRAW, 0},
+    [XANIME_PROP_SHADOW_WIDTH] = {"shadow_width", shadow_width_get, shadow_width_exec_cb, XANIME_VALUE_INT,
+                                  XANIME_INVALIDATE_REDRAW, 0},
+    [XANIME_PROP_TRANSLATE_X] = {"translate_x", translate_x_get, translate_x_exec_cb, XANIME_VALUE_INT,
+                                 XANIME_INVALIDATE_LAYOUT, 0},
+    [XANIME_PROP_TRANSLATE_Y] = {"translate_y", translate_y_get, translate_y_exec_cb, XANIME_VALUE_INT,
+                                 XANIME_INVALIDATE_LAYOUT, 0},
+    [XANIME_PROP_LETTER_SPACE] = {"letter_space", letter_space_get, letter_space_exec_cb, XANIME_VALUE_INT,
+                                  XANIME_INVALIDATE_REDRAW, 0},
+};
+
+// 按失效范围与数值类型汇总的属性位图，注册自定义通道时更新
+static uint32_t channel_kind_mask[XANIME_INVALIDATE_LAYOUT + 1] = {
+    [XANIME_INVALIDATE_REDRAW] = XANIME_PROP_BIT(XANIME_PROP_BG_COLOR) | XANIME_PROP_BIT(XANIME_PROP_BORDER_COLOR) |
+                                 XANIME_PROP_BIT(XANIME_PROP_TEXT_COLOR) | XANIME_PROP_BIT(XANIME_PROP_BORDER_WIDTH) |
+                                 XANIME_PROP_BIT(XANIME_PROP_SHADOW_WIDTH) | XANIME_PROP_BIT(XANIME_PROP_LETTER_SPACE),
+    [XANIME_INVALIDATE_TRANSFORM] = XANIME_PROP_BIT(XANIME_PROP_OPACITY) | XANIME_PROP_BIT(XANIME_PROP_ROTATE) |
+                                    XANIME_PROP_BIT(XANIME_PROP_SCALE),
+    [XANIME_INVALIDATE_LAYOUT] = XANIME_PROP_BIT(XANIME_PROP_X) | XANIME_PROP_BIT(XANIME_PROP_Y) |
+                                 XANIME_PROP_BIT(XANIME_PROP_WIDTH) | XANIME_PROP_BIT(XANIME_PROP_HEIGHT) |
+                                 XANIME_PROP_BIT(XANIME_PROP_TRANSLATE_X) | XANIME_PROP_BIT(XANIME_PROP_TRANSLATE_Y),
+};
+static uint32_t channel_color_mask = XANIME_PROP_BIT(XANIME_PROP_BG_COLOR) |
+                                     XANIME_PROP_BIT(XANIME_PROP_BORDER_COLOR) |
+                                     XANIME_PROP_BIT(XANIME_PROP_TEXT_COLOR);
+// 已注册的自定义通道数量
+static uint8_t channel_custom_num;
+
+/********************************************************************************
+ * @brief: 初始化编译后的动画描述
+ * @param {xanime_spec_t*} spec
+ * @param {uint32_t} dur
+ * @return {*}
+ ********************************************************************************/
+void xanime_spec_init(xanime_spec_t *spec, uint32_t dur)
+{
+    if (!spec)
+        return;
+    memset(spec, 0, sizeof(xanime_spec_t));
+    spec->dur = dur;
+}
+
+/********************************************************************************
+ * @brief: 设置动画描述中的属性目标值
+ * @param {xanime_spec_t*} spec
+ * @param {xanime_prop_t} prop
+ * @param {xanime_value_t} value
+ * @return {*}
+ ********************************************************************************/
+void xanime_spec_set(xanime_spec_t *spec, xanime_prop_t prop, xanime_value_t value)
+{
+    if (!spec || prop >= XANIME_PROP_COUNT)
+        return;
+    if (prop < XANIME_PROP_ANIM_COUNT && !channel_table[prop].set)
+    {
+        printf("Error: Channel %d is not registered\n", prop);
+        return;
+    }
+    spec->values[prop] = value;
+    spec->mask |= XANIME_PROP_BIT(prop);
+    // 目标值代替之前设置的关键帧轨道
+    if (prop < XANIME_PROP_ANIM_COUNT)
+        spec->tracks[prop].num = 0;
+}
+
+/********************************************************************************
+ * @brief: 设置属性的关键帧轨道，关键帧数组需在动画启动前保持有效
+ * @param {xanime_spec_t*} spec
+ * @param {xanime_prop_t} prop 可动画属性
+ * @param {xanime_keyframe_t*} frames 按时间升序排列的关键帧
+ * @param {uint16_t} num 关键帧数量
+ * @return {*} 参数无效时返回 false
+ ********************************************************************************/
+bool xanime_spec_set_track(xanime_spec_t *spec, xanime_prop_t prop, const xanime_keyframe_t *frames, uint16_t num)
+{
+    if (!spec || prop >= XANIME_PROP_ANIM_COUNT || !channel_table[prop].set || !frames || num == 0)
+        return false;
+    for (uint16_t i = 1; i < num; i++)
+    {
+        if (frames[i].time < frames[i - 1].time)
+        {
+            printf("Error: Keyframes of %s are not sorted by time\n", prop_name(prop));
+            return false;
+        }
+    }
+
+    spec->tracks[prop].frames = frames;
+    spec->tracks[prop].num = num;
+    spec->mask |= XANIME_PROP_BIT(prop);
+    // 总时长至少覆盖最后一个关键帧
+    if (spec->dur < frames[num - 1].time)
+        spec->dur = frames[num - 1].time;
+    return true;
+}
+
+/********************************************************************************
+ * @brief: 将字符串参数编译为数值动画描述，一次性报告所有解析错误
+ * @param {xanime_param_t*} params
+ * @param {xanime_spec_t*} spec
+ * @return {*} 错误位图，0 表示成功 (XANIME_PROP_BIT / XANIME_ERR_*)
+ ********************************************************************************/
+uint32_t xanime_compile(const xanime_param_t *params, xanime_spec_t *spec)
+{
+    if (!params || !spec)
+        return XANIME_ERR_DUR;
+
+    uint32_t err = 0;
+    xanime_value_t val;
+    xanime_spec_init(spec, 0);
+
+    // 时间参数只接受绝对数值；弹簧在静止时结束，dur 为可选的最长时长
+    if (params->spring && !check_param(params->dur))
+        spec->dur = XANIME_SPRING_DUR_MAX;
+    else if (!parse_value(params->dur, &val) || val.unit != XANIME_UNIT_PX || val.value <= 0)
+    {
+        printf("Error: Invalid dur value '%s'\n", params->dur ? params->dur : "(null)");
+        err |= XANIME_ERR_DUR;
+    }
+    else
+    {
+        spec->dur = val.value;
+    }
+    if (check_param(params->delay))
+    {
+        if (!parse_value(params->delay, &val) || val.unit != XANIME_UNIT_PX || val.value < 0)
+        {
+            printf("Error: Invalid delay value '%s'\n", params->delay);
+            err |= XANIME_ERR_DELAY;
+        }
+        else
+        {
+            spec->delay = val.value;
+        }
+    }
+    if (check_param(params->loop))
+    {
+        if (!parse_value(params->loop, &val) || val.unit != XANIME_UNIT_PX)
+        {
+            printf("Error: Invalid loop value '%s'\n", params->loop);
+            err |= XANIME_ERR_LOOP;
+        }
+        else
+        {
+            spec->loop = val.value;
+        }
+    }
+    if (check_param(params->stagger))
+    {
+        if (!parse_value(params->stagger, &val) || val.unit != XANIME_UNIT_PX || val.value < 0)
+        {
+            printf("Error: Invalid stagger value '%s'\n", params->stagger);
+            err |= XANIME_ERR_STAGGER;
+        }
+        else
+        {
+            spec->stagger = val.value;
+        }
+    }
+
+    // 字符串字段对应的属性，其余属性为 NULL
+    const char *props[XANIME_PROP_COUNT] = {
+        [XANIME_PROP_X] = params->x,
+        [XANIME_PROP_Y] = params->y,
+        [XANIME_PROP_WIDTH] = params->width,
+        [XANIME_PROP_HEIGHT] = params->height,
+        [XANIME_PROP_OPACITY] = params->opacity,
+        [XANIME_PROP_ROTATE] = params->rotate,
+        [XANIME_PROP_SCALE] = params->scale,
+        [XANIME_PROP_PIVOT_X] = params->pivot_x,
+        [XANIME_PROP_PIVOT_Y] = params->pivot_y,
+    };
+    for (uint8_t i = 0; i < params->channel_num && params->channels; i++)
+    {
+        xanime_prop_t prop = params->channels[i].prop;
+        if ((uint32_t)prop >= XANIME_PROP_ANIM_COUNT || !channel_table[prop].set)
+        {
+            printf("Error: Channel %d is not registered\n", prop);
+            err |= XANIME_ERR_CHANNEL;
+            continue;
+        }
+        props[prop] = params->channels[i].value;
+    }
+    for (uint8_t i = 0; i < XANIME_PROP_COUNT; i++)
+    {
+        if (!check_param(props[i]))
+            continue;
+        // 颜色只接受 "#RRGGBB" / "#RGB"，没有百分比参照值的属性不接受百分比
+        bool ok = prop_is_color(i) ? parse_color(props[i], &val) : parse_value(props[i], &val);
+        if (!ok || (val.unit == XANIME_UNIT_PERCENT && !prop_percent_ok(i)))
+        {
+            printf("Error: Invalid %s value '%s'\n", prop_name(i), props[i]);
+            err |= XANIME_PROP_BIT(i);
+            continue;
+        }
+        xanime_spec_set(spec, i, val);
+    }
+
+    // 运动路径代替 x / y 与自动旋转时的 rotate
+    if (params->path)
+    {
+        uint32_t used = XANIME_PROP_BIT(XANIME_PROP_X) | XANIME_PROP_BIT(XANIME_PROP_Y) |
+                        (params->path->auto_rotate ? XANIME_PROP_BIT(XANIME_PROP_ROTATE) : 0);
+        if (spec->mask & used)
+        {
+            printf("Error: Motion path conflicts with x / y / rotate\n");
+            err |= XANIME_ERR_PATH;
+        }
+        else if (!xanime_spec_set_path(spec, params->path))
+            err |= XANIME_ERR_PATH;
+    }
+
+    if (params->spring)
+    {
+        spec->is_spring = true;
+        spec->spring = *params->spring;
+        if (params->path)
+        {
+            printf("Error: Motion path cannot be driven by a spring\n");
+            err |= XANIME_ERR_PATH;
+        }
+        // 颜色按分量插值，没有弹簧的位移
+        for (uint32_t mask = spec->mask & channel_color_mask; mask;)
+        {
+            uint8_t prop = mask_pop(&mask);
+            printf("Error: Color channel %s cannot be driven by a spring\n", prop_name(prop));
+            err |= XANIME_PROP_BIT(prop);
+        }
+    }
+
+    spec->auto_play = params->auto_play;
+    spec->is_from = params->is_from;
+    spec->skip_layout = params->skip_layout;
+    spec->use_translate = params->use_translate;
+    spec->flip_size = params->flip_size;
+    spec->snapshot = params->snapshot;
+    spec->sprite_frames = params->sprite_frames;
+    spec->threshold = params->threshold;
+    spec->easing = params->easing;
+    spec->mode = params->mode;
+    spec->priority = params->priority;
+    spec->fps = params->fps;
+    spec->overwrite = params->overwrite;
+    spec->stagger_from = params->stagger_from;
+    spec->stagger_grid = params->stagger_grid;
+    spec->stagger_easing = params->stagger_easing;
+    spec->event_cb = params->event_cb;
+    spec->complete_cb = params->complete_cb;
+    spec->user_data = params->user_data;
+    spec_resolve_mode(spec);
+
+    return err;
+}
+
+/********************************************************************************
+ * @brief: 设置运动路径，路径驱动 x / y，自动旋转时同时驱动 rotate
+ * @param {xanime_spec_t*} spec
+ * @param {xanime_path_t*} path 路径与其中的点需要一直有效
+ * @return {*} 路径不合法时返回 false
+ ********************************************************************************/
+bool xanime_spec_set_path(xanime_spec_t *spec, const xanime_path_t *path)
+{
+    if (!spec || !path || !path->points || path->point_num < 2 || path->type > XANIME_PATH_BEZIER ||
+        (path->type == XANIME_PATH_BEZIER &&
+         ((path->point_num - 1) % 3 != 0 || (path->point_num - 1) / 3 * XANIME_PATH_BEZIER_STEPS >= UINT16_MAX)))
+    {
+        printf("Error: Invalid motion path\n");
+        return false;
+    }
+    // 目标值为路径终点，只用于覆盖与起止判断，每帧的值由路径计算
+    const lv_point_t *end = &path->points[path->point_num - 1];
+    spec->path = path;
+    xanime_spec_set(spec, XANIME_PROP_X, path->relative ? XANIME_REL(end->x) : XANIME_PX(end->x));
+    xanime_spec_set(spec, XANIME_PROP_Y, path->relative ? XANIME_REL(end->y) : XANIME_PX(end->y));
+    if (path->auto_rotate)
+        xanime_spec_set(spec, XANIME_PROP_ROTATE, XANIME_PX(path->rotate_offset));
+    return true;
+}
+
+/********************************************************************************
+ * @brief: 创建单个动画
+ * @param {lv_obj_t} obj
+ * @param {xanime_param_t} params
+ * @return {*}
+ ********************************************************************************/
+void xanime_create_single(lv_obj_t *obj, xanime_param_t params)
+{
+    lv_obj_t *obj_arr[1] = {obj};
+    xanime_create((xanime_obj_t){.obj_num = 1, .obj_arr = obj_arr}, params);
+}
+
+/********************************************************************************
+ * @brief: 创建并执行动画控制器
+ * @param {xanime_obj_t} obj
+ * @param {xanime_param_t} params
+ * @return {*}
+ ********************************************************************************/
+void xanime_create(xanime_obj_t obj, xanime_param_t params)
+{
+    if (obj.obj_num == 0)
+        return;
+    xanime_spec_t spec;
+    if (xanime_compile(&params, &spec) != 0)
+        return;
+
+    xanime_create_spec(obj, &spec);
+}
+
+/********************************************************************************
+ * @brief: 创建单个动画有返回值，返回动画控制器指针
+ * @param {lv_obj_t*} obj
+ * @param {xanime_param_t} params
+ * @return {*}
+ ********************************************************************************/
+xanime_t *xanime_create_single_rt(lv_obj_t *obj, xanime_param_t params)
+{
+    lv_obj_t *obj_arr[1] = {obj};
+    return xanime_create_rt((xanime_obj_t){.obj_num = 1, .obj_arr = obj_arr},
+
+                            params);
+}
+
+/********************************************************************************
+ * @brief: 创建动画控制器有返回值，返回动画控制器指针
+ * @param {xanime_obj_t} obj
+ * @param {xanime_param_t} params
+ * @return {*}
+ ********************************************************************************/
+xanime_t *xanime_create_rt(xanime_obj_t obj, xanime_param_t params)
+{
+    if (obj.obj_num == 0)
+        return NULL;
+    xanime_spec_t spec;
+    if (xanime_compile(&params, &spec) != 0)
+        return NULL;
+
+    xanime_t *anime = anime_alloc(obj, &spec);
+    if (!anime)
+        return NULL;
+    anime->params = params;
+
+    // 自动播放
+    if (spec.auto_play)
+    {
+        xanime_start(anime);
+    }
+
+    return anime;
+}
+
+/********************************************************************************
+ * @brief: 使用编译后的动画描述创建并执行动画，不涉及字符串解析
+ * @param {xanime_obj_t} obj
+ * @param {xanime_spec_t*} spec
+ * @return {*}
+ ********************************************************************************/
+void xanime_create_spec(xanime_obj_t obj, const xanime_spec_t *spec)
+{
+    if (obj.obj_num == 0 || !spec || spec->dur == 0)
+        return;
+
+    anime_priv_t priv;
+    memset(&priv, 0, sizeof(anime_priv_t));
+    xanime_t *anime = &priv.pub;
+
+    // 复制对象数组
+    anime->obj.obj_arr = obj.obj_arr;
+    anime->obj.obj_num = obj.obj_num;
+    anime->spec = *spec;
+    spec_resolve_mode(&anime->spec);
+
+    // 初始化状态
+    anime->is_playing = false;
+
+    // 自动播放，控制器在栈上，组动画结束后自行释放
+    anime_start(anime, true);
+    // 路径查找表由已启动的动画持有
+    path_lut_put(priv.path_lut);
+}
+
+/********************************************************************************
+ * @brief: 使用编译后的动画描述创建动画控制器，返回动画控制器指针
+ * @param {xanime_obj_t} obj
+ * @param {xanime_spec_t*} spec
+ * @return {*}
+ ********************************************************************************/
+xanime_t *xanime_create_spec_rt(xanime_obj_t obj, const xanime_spec_t *spec)
+{
+    if (obj.obj_num == 0 || !spec || spec->dur == 0)
+        return NULL;
+
+    xanime_t *anime = anime_alloc(obj, spec);
+    if (!anime)
+        return NULL;
+
+    // 自动播放
+    if (spec->auto_play)
+    {
+        xanime_start(anime);
+    }
+
+    return anime;
+}
+
+/********************************************************************************
+ * @brief: 分配并初始化动画控制器
+ * @param {xanime_obj_t} obj
+ * @param {xanime_spec_t*} spec
+ * @return {*}
+ ********************************************************************************/
+static xanime_t *anime_alloc(xanime_obj_t obj, const xanime_spec_t *spec)
+{
+    // 控制器、对象数组与 lv_anim 记录一次分配
+    uint32_t slot_num = anime_slot_count(spec, obj.obj_num);
+    xanime_t *anime =
+        pool_alloc(XANIME_POOL_ANIME, sizeof(anime_priv_t) + obj.obj_num * sizeof(lv_obj_t *) + slot_num * sizeof(anim_slot_t));
+    if (!anime)
+        return NULL;
+
+    memset(anime, 0, sizeof(anime_priv_t));
+
+    // 复制对象数组，调用方的数组可以是临时的
+    anime->obj.obj_arr = (lv_obj_t **)(ANIME_PRIV(anime) + 1);
+    anime->obj.obj_num = obj.obj_num;
+    memcpy(anime->obj.obj_arr, obj.obj_arr, obj.obj_num * sizeof(lv_obj_t *));
+    anime->spec = *spec;
+    // 手动构建的描述没有经过编译
+    spec_resolve_mode(&anime->spec);
+    anime_priv_t *priv = ANIME_PRIV(anime);
+    priv->slots = slot_num ? (anim_slot_t *)(anime->obj.obj_arr + obj.obj_num) : NULL;
+    priv->slot_num = slot_num;
+    priv->handle = handle_register(anime);
+
+    // 对象删除时从控制器中移除
+    for (uint16_t i = 0; i < obj.obj_num; i++)
+    {
+        if (anime->obj.obj_arr[i])
+            lv_obj_add_event_cb(anime->obj.obj_arr[i], anime_obj_delete_cb, LV_EVENT_DELETE, anime);
+    }
+
+    // 初始化状态
+    anime->is_playing = false;
+
+    return anime;
+}
+
+/********************************************************************************
+ * @brief: 控制器最多同时运行的 lv_anim 数量，组动画不需要记录
+ * @param {xanime_spec_t*} spec
+ * @param {uint16_t} obj_num
+ * @return {*}
+ ********************************************************************************/
+static uint32_t anime_slot_count(const xanime_spec_t *spec, uint16_t obj_num)
+{
+    if (spec_grouped(spec))
+        return 0;
+    if (spec->mode == XANIME_MODE_FUSED)
+        return obj_num;
+
+    uint32_t ch_num = 0;
+    for (uint32_t mask = spec->mask & (XANIME_PROP_BIT(ANIM_PROP_COUNT) - 1); mask; mask &= mask - 1)
+        ch_num++;
+    return ch_num * obj_num;
+}
+
+/********************************************************************************
+ * @brief: 取一条空闲的 lv_anim 记录
+ * @param {xanime_t*} anime
+ * @return {*} 自动播放的控制器或记录用完时返回 NULL
+ ********************************************************************************/
+static anim_slot_t *anime_slot_take(xanime_t *anime)
+{
+    anime_priv_t *priv = ANIME_PRIV(anime);
+    if (!priv->slots || priv->slot_used >= priv->slot_num)
+        return NULL;
+    anim_slot_t *slot = &priv->slots[priv->slot_used++];
+    slot->owner = anime;
+    slot->anim = NULL;
+    return slot;
+}
+
+/********************************************************************************
+ * @brief: 记录已启动的 lv_anim
+ * @param {anim_slot_t*} slot
+ * @param {lv_anim_t*} anim lv_anim_start 的返回值
+ * @return {*}
+ ********************************************************************************/
+static void anime_slot_bind(anim_slot_t *slot, lv_anim_t *anim)
+{
+    if (!slot || !anim)
+        return;
+    slot->anim = anim;
+    ANIME_PRIV(slot->owner)->slot_live++;
+}
+
+/********************************************************************************
+ * @brief: lv_anim 被删除 (完成、取消或对象删除) 时清空记录
+ * @param {anim_slot_t*} slot
+ * @return {*}
+ ********************************************************************************/
+static void anime_slot_release(anim_slot_t *slot)
+{
+    if (!slot || !slot->anim)
+        return;
+    slot->anim = NULL;
+    xanime_t *owner = slot->owner;
+    if (--ANIME_PRIV(owner)->slot_live == 0)
+        owner->is_playing = false;
+}
+
+/********************************************************************************
+ * @brief: 控制器持有的属性动画完成回调，还原用户数据后调用用户回调
+ * @param {lv_anim_t*} a
+ * @return {*}
+ ********************************************************************************/
+static void anime_slot_ready_cb(lv_anim_t *a)
+{
+    anim_slot_t *slot = a->user_data;
+    const xanime_spec_t *spec = &slot->owner->spec;
+    if (!spec->complete_cb)
+        return;
+    lv_anim_t user_anim = *a;
+    user_anim.user_data = spec->user_data;
+    spec->complete_cb(&user_anim);
+}
+
+/********************************************************************************
+ * @brief: 控制器持有的属性动画删除回调
+ * @param {lv_anim_t*} a
+ * @return {*}
+ ********************************************************************************/
+static void anime_slot_deleted_cb(lv_anim_t *a)
+{
+    anime_slot_release(a->user_data);
+}
+
+/********************************************************************************
+ * @brief: 取消控制器启动的所有 lv_anim
+ * @param {xanime_t*} anime
+ * @return {*}
+ ********************************************************************************/
+static void anime_cancel(xanime_t *anime)
+{
+    anime_priv_t *priv = ANIME_PRIV(anime);
+    for (uint32_t i = 0; i < priv->slot_used; i++)
+    {
+        anim_slot_t *slot = &priv->slots[i];
+        if (!slot->anim)
+            continue;
+        // 同一对象上可能还有其他控制器的融合动画，先把 var 换成记录本身，按 var 只删除这一个
+        slot->anim->var = slot;
+        lv_anim_delete(slot, NULL);
+    }
+    priv->slot_used = 0;
+}
+
+/********************************************************************************
+ * @brief: 控制器的目标对象被删除时从对象数组中移除
+ * @param {lv_event_t*} e
+ * @return {*}
+ ********************************************************************************/
+static void anime_obj_delete_cb(lv_event_t *e)
+{
+    xanime_t *anime = lv_event_get_user_data(e);
+    lv_obj_t *obj = lv_event_get_target(e);
+    for (uint16_t i = 0; i < anime->obj.obj_num; i++)
+    {
+        if (anime->obj.obj_arr[i] == obj)
+            anime->obj.obj_arr[i] = NULL;
+    }
+}
+
+/********************************************************************************
+ * @brief: 获取 (对象, 属性) 所在的桶
+ * @param {lv_obj_t*} obj
+ * @param {uint8_t} prop
+ * @return {*}
+ ********************************************************************************/
+static claim_t **claim_bucket(const lv_obj_t *obj, uint8_t prop)
+{
+    uint32_t h = (uint32_t)((uintptr_t)obj >> 3) * 0x9E3779B1u + prop * 0x85EBCA6Bu;
+    return &claim_index.buckets[(h ^ (h >> 16)) & (claim_index.size - 1)];
+}
+
+/********************************************************************************
+ * @brief: 将记录加入覆盖索引，扩容失败时继续使用原来的桶
+ * @param {claim_t*} claim
+ * @return {*}
+ ********************************************************************************/
+static void claim_insert(claim_t *claim)
+{
+    if (claim_index.count >= claim_index.size * 2)
+    {
+        uint32_t size = claim_index.size ? claim_index.size * 2 : 16;
+        claim_t **buckets = XANIME_MALLOC(size * sizeof(claim_t *));
+        if (buckets)
+        {
+            memset(buckets, 0, size * sizeof(claim_t *));
+            claim_t **old = claim_index.buckets;
+            uint32_t old_size = claim_index.size;
+            claim_index.buckets = buckets;
+            claim_index.size = size;
+            for (uint32_t b = 0; b < old_size; b++)
+            {
+                for (claim_t *c = old[b], *next; c; c = next)
+                {
+                    next = c->next;
+                    claim_t **bucket = claim_bucket(c->obj, c->prop);
+                    c->next = *bucket;
+                    *bucket = c;
+                }
+            }
+            XANIME_FREE(old);
+        }
+    }
+    // 索引分配失败时不登记，该动画不会被覆盖
+    if (claim_index.size == 0)
+        return;
+    claim_t **bucket = claim_bucket(claim->obj, claim->prop);
+    claim->next = *bucket;
+    *bucket = claim;
+    claim_index.count++;
+}
+
+/********************************************************************************
+ * @brief: 将记录从覆盖索引中移除，不在索引中时忽略
+ * @param {claim_t*} claim
+ * @return {*}
+ ********************************************************************************/
+static void claim_remove(claim_t *claim)
+{
+    if (claim_index.size == 0)
+        return;
+    for (claim_t **link = claim_bucket(claim->obj, claim->prop); *link; link = &(*link)->next)
+    {
+        if (*link == claim)
+        {
+            *link = claim->next;
+            claim->next = NULL;
+            claim_index.count--;
+            return;
+        }
+    }
+}
+
+/********************************************************************************
+ * @brief: 停止记录对应的属性，所属动画的所有属性都被覆盖时停止该动画，不调用完成回调
+ * @param {claim_t*} claim
+ * @return {*}
+ ********************************************************************************/
+static void claim_kill(claim_t *claim)
+{
+    claim_remove(claim);
+    claim->live = false;
+    if (claim->is_group)
+    {
+        // 组动画在驱动的下一帧结束，避免在驱动遍历中释放
+        group_anim_t *g = claim->runner;
+        if (--g->claim_live == 0)
+            g->killed = true;
+        return;
+    }
+    fused_anim_t *fa = claim->runner;
+    if (--fa->claim_live > 0)
+        return;
+    // 同一对象上可能还有其他融合动画，先把 var 换成通道表本身，按 var 只删除这一个
+    fa->anim->var = fa;
+    lv_anim_delete(fa, NULL);
+}
+
+/********************************************************************************
+ * @brief: 判断记录是否属于控制器自己的动画
+ * @param {claim_t*} claim
+ * @param {xanime_t*} anime
+ * @return {*}
+ ********************************************************************************/
+static bool claim_owned(const claim_t *claim, const xanime_t *anime)
+{
+    if (claim->is_group)
+        return claim->runner == ANIME_PRIV(anime)->runner;
+    const fused_anim_t *fa = claim->runner;
+    return fa->slot && fa->slot->owner == anime;
+}
+
+/********************************************************************************
+ * @brief: 按覆盖策略停止目标对象上冲突的组模式与融合模式动画
+ * @param {xanime_t*} anime
+ * @return {*}
+ ********************************************************************************/
+static void overwrite_conflicts(xanime_t *anime)
+{
+    const xanime_spec_t *spec = &anime->spec;
+    if (spec->overwrite == XANIME_OVERWRITE_NONE || claim_index.count == 0)
+        return;
+    uint32_t mask = spec->mask;
+    if (spec->overwrite == XANIME_OVERWRITE_ALL)
+        mask = XANIME_PROP_BIT(ANIM_PROP_COUNT) - 1;
+
+    for (uint16_t i = 0; i < anime->obj.obj_num; i++)
+    {
+        lv_obj_t *obj = anime->obj.obj_arr[i];
+        if (!obj)
+            continue;
+        for (uint32_t left = mask & (XANIME_PROP_BIT(ANIM_PROP_COUNT) - 1); left;)
+        {
+            uint8_t prop = mask_pop(&left);
+            // 停止动画可能移除同一桶中的其他记录，每次停止后从桶头重新查找
+            claim_t **bucket = claim_bucket(obj, prop);
+            for (claim_t *c = *bucket; c;)
+            {
+                if (c->obj == obj && c->prop == prop && !claim_owned(c, anime))
+                {
+                    claim_kill(c);
+                    c = *bucket;
+                    continue;
+                }
+                c = c->next;
+            }
+        }
+    }
+}
+
+/********************************************************************************
+ * @brief: 启动动画
+ * @param {xanime_t*} anime
+ * @return {*}
+ ********************************************************************************/
+xanime_t *xanime_start(xanime_t *anime)
+{
+    return anime_start(anime, false);
+}
+
+/********************************************************************************
+ * @brief: 启动动画，组动画由控制器持有，结束后保留已解析的状态
+ * @param {xanime_t*} anime
+ * @param {bool} detached 组动画不关联控制器，结束后自动释放
+ * @return {*} 组动画创建失败时返回 NULL
+ ********************************************************************************/
+static xanime_t *anime_start(xanime_t *anime, bool detached)
+{
+    if (!anime || !anime->obj.obj_arr || anime->is_playing)
+        return anime;
+
+    if (anime->obj.obj_num == 0)
+    {
+        return NULL;
+    }
+    // 已经解析过，暂停时继续播放，否则从头播放，不再刷新布局与分配
+    if (ANIME_PRIV(anime)->runner)
+        return anime->is_paused ? xanime_resume(anime) : xanime_restart(anime);
+    // 先停止冲突的动画，起始值从它们停下时的值读取
+    overwrite_conflicts(anime);
+    // 路径查找表只构建一次，之后的启动直接复用；构建失败时按直线运动
+    if (anime->spec.path && !ANIME_PRIV(anime)->path_lut)
+        ANIME_PRIV(anime)->path_lut = path_lut_build(&anime->spec);
+
+    // 每个屏幕只刷新一次布局，之后所有对象从同一份有效布局读取起始值
+    refresh_layout(anime);
+    bool need_geom = spec_needs_geom(&anime->spec);
+
+    // 组动画，整个控制器只注册一个驱动节点；关键帧轨道与弹簧也由组动画驱动
+    if (spec_grouped(&anime->spec))
+    {
+        group_anim_t *g = group_start(anime, need_geom);
+        // 分配失败或没有可动画的属性
+        if (!g)
+            return NULL;
+        if (!detached)
+        {
+            g->owner = anime;
+            ANIME_PRIV(anime)->runner = g;
+        }
+        if (anime->spec.overwrite != XANIME_OVERWRITE_NONE)
+            group_claim(g);
+        anime->is_playing = true;
+        anime_emit(anime, XANIME_EVENT_START);
+        return anime;
+    }
+    // 上一次启动的动画已全部结束，记录从头使用
+    anime_cancel(anime);
+
+    // 循环创建动画
+    geom_snapshot_t geom = {0};
+    for (uint16_t i = 0; i < anime->obj.obj_num; i++)
+    {
+        lv_obj_t *cur_obj = anime->obj.obj_arr[i];
+        // 已删除的对象
+        if (!cur_obj)
+            continue;
+        if (need_geom)
+            geom_snapshot(&geom, cur_obj);
+        // 初始化动画
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, cur_obj);
+
+        // 错开的对象推迟开始
+        param_handle(&a, anime, cur_obj, &geom, anime->spec.delay + stagger_offset(&anime->spec, i, anime->obj.obj_num));
+    }
+
+    // 控制器持有的动画在最后一个 lv_anim 结束时清除播放状态
+    anime_priv_t *priv = ANIME_PRIV(anime);
+    anime->is_playing = priv->slots ? priv->slot_live > 0 : true;
+    priv->event_round = 0;
+    if (priv->slot_live > 0)
+        anime_emit(anime, XANIME_EVENT_START);
+
+    return anime; // 返回控制器指针以支持链式调用
+}
+
+/********************************************************************************
+ * @brief: 检查参数是否有效
+ * @param {const char*} param
+ * @return {*}
+ ********************************************************************************/
+bool check_param(const char *param)
+{
+    if (param == NULL || param[0] == '\0' || strcmp(param, "") == 0)
+    {
+        return false;
+    }
+    return true;
+}
+
+/********************************************************************************
+ * @brief: 处理动画参数
+ * @param {lv_anim_t*} anim
+ * @param {xanime_t*} anime
+ * @param {lv_obj_t*} obj
+ * @return {*}
+ ********************************************************************************/
+void anime_param_handle(lv_anim_t *anim, xanime_t *anime, lv_obj_t *obj)
+{
+    geom_snapshot_t geom = {0};
+    if (!anime->spec.skip_layout)
+        lv_obj_update_layout(obj);
+    if (spec_needs_geom(&anime->spec))
+        geom_snapshot(&geom, obj);
+    param_handle(anim, anime, obj, &geom, anime->spec.delay);
+}
+
+/********************************************************************************
+ * @brief: 使用几何快照处理动画参数
+ * @param {lv_anim_t*} anim
+ * @param {xanime_t*} anime
+ * @param {lv_obj_t*} obj
+ * @param {geom_snapshot_t*} geom
+ * @param {uint32_t} delay 包含错开时间的延迟
+ * @return {*}
+ ********************************************************************************/
+static void param_handle(lv_anim_t *anim, xanime_t *anime, lv_obj_t *obj, const geom_snapshot_t *geom,
+                         uint32_t delay)
+{
+    const xanime_spec_t *spec = &anime->spec;
+
+    // duration
+    lv_anim_set_time(anim, spec->dur);
+    // delay
+    lv_anim_set_delay(anim, delay);
+    // complete callback
+    if (spec->complete_cb != NULL)
+    {
+        lv_anim_set_ready_cb(anim, spec->complete_cb);
+    }
+    // loop
+    if (spec->loop != 0)
+    {
+        lv_anim_set_repeat_count(anim, spec->loop < 0 ? LV_ANIM_REPEAT_INFINITE : (uint32_t)spec->loop);
+    }
+    // user data
+    if (spec->user_data != NULL)
+    {
+        lv_anim_set_user_data(anim, spec->user_data);
+    }
+    // easing
+    lv_anim_set_path_cb(anim, get_easing_func(spec->easing));
+    // pivot
+    apply_pivot(anime, obj, geom);
+
+    anim_channel_t ch[ANIM_PROP_COUNT];
+    uint8_t ch_num = resolve_channels(anime, obj, geom, ch);
+    if (ch_num == 0)
+        return;
+
+    // 需要融合驱动的属性模式在创建时已改为融合模式
+    if (spec->mode == XANIME_MODE_FUSED)
+    {
+        fused_start(anim, anime, ch, ch_num);
+        return;
+    }
+
+    for (uint8_t i = 0; i < ch_num; i++)
+    {
+        anim_property_start(anime, anim, ch[i].exec_cb, ch[i].start, ch[i].end);
+    }
+}
+
+/********************************************************************************
+ * @brief: 解析对象上所有已设置属性的起止值
+ * @param {xanime_t*} anime
+ * @param {lv_obj_t*} obj
+ * @param {geom_snapshot_t*} geom
+ * @param {anim_channel_t*} ch 输出通道表，至少 ANIM_PROP_COUNT 项
+ * @return {*} 通道数量
+ ********************************************************************************/
+static uint8_t resolve_channels(xanime_t *anime, lv_obj_t *obj, const geom_snapshot_t *geom, anim_channel_t *ch)
+{
+    const xanime_spec_t *spec = &anime->spec;
+    uint8_t ch_num = 0;
+
+    // 只遍历设置了的通道
+    for (uint32_t mask = spec->mask & (XANIME_PROP_BIT(ANIM_PROP_COUNT) - 1); mask;)
+    {
+        uint8_t prop = mask_pop(&mask);
+        int32_t start = prop_get_value(prop, obj);
+        lv_anim_exec_xcb_t exec_cb = prop_exec_cb(prop);
+
+        ch[ch_num].exec_cb = exec_cb;
+        ch[ch_num].prop = prop;
+        ch[ch_num].start = start;
+        ch[ch_num].end = resolve_value(prop, geom, spec->values[prop], start);
+        if (spec->use_translate && prop_is_position(prop) && path_axis(spec, prop) == PATH_AXIS_NONE)
+            translate_channel(obj, prop, spec->is_from, &ch[ch_num]);
+        else if (spec_flip_size(spec) && prop_is_size(prop))
+            flip_channel(obj, prop, spec->is_from, &ch[ch_num]);
+        ch_num++;
+    }
+
+    return ch_num;
+}
+
+/********************************************************************************
+ * @brief: 判断属性是否为位置
+ * @param {uint8_t} prop
+ * @return {*}
+ ********************************************************************************/
+static bool prop_is_position(uint8_t prop)
+{
+    return prop == XANIME_PROP_X || prop == XANIME_PROP_Y;
+}
+
+/********************************************************************************
+ * @brief: 将位置终点一次性提交为对象坐标，之后的移动只修改 translate
+ * @param {lv_obj_t*} obj
+ * @param {uint8_t} prop XANIME_PROP_X / XANIME_PROP_Y
+ * @param {int32_t} end 终点坐标
+ * @param {int32_t} cur 当前坐标
+ * @return {*} 动画开始前 translate 的值，作为偏移的基准
+ ********************************************************************************/
+static int32_t translate_commit(lv_obj_t *obj, uint8_t prop, int32_t end, int32_t cur)
+{
+    if (prop == XANIME_PROP_X)
+    {
+        if (end != cur)
+            lv_obj_set_x(obj, end);
+        return lv_obj_get_style_translate_x(obj, LV_PART_MAIN);
+    }
+    if (end != cur)
+        lv_obj_set_y(obj, end);
+    return lv_obj_get_style_translate_y(obj, LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 将位置通道转换为 translate 偏移，终点坐标在开始时提交，结束时偏移回到原值
+ * @param {lv_obj_t*} obj
+ * @param {uint8_t} prop XANIME_PROP_X / XANIME_PROP_Y
+ * @param {bool} is_from 反向播放，终点为当前位置，不需要提交
+ * @param {anim_channel_t*} ch
+ * @return {*}
+ ********************************************************************************/
+static void translate_channel(lv_obj_t *obj, uint8_t prop, bool is_from, anim_channel_t *ch)
+{
+    int32_t delta = ch->end - ch->start;
+    int32_t base = translate_commit(obj, prop, is_from ? ch->start : ch->end, ch->start);
+
+    ch->exec_cb = prop == XANIME_PROP_X ? translate_x_exec_cb : translate_y_exec_cb;
+    if (is_from)
+    {
+        // 起止值在启动时交换，从目标位置移回
+        ch->start = base;
+        ch->end = base + delta;
+        return;
+    }
+    // 立即从原位置开始显示，避免延迟期间停在终点
+    ch->start = base - delta;
+    ch->end = base;
+    ch->exec_cb(obj, ch->start);
+}
+
+/********************************************************************************
+ * @brief: 判断尺寸动画是否使用缩放变换，同时设置了缩放属性时两者会互相覆盖，不使用
+ * @param {xanime_spec_t*} spec
+ * @return {*}
+ ********************************************************************************/
+static bool spec_flip_size(const xanime_spec_t *spec)
+{
+    return spec->flip_size && !(spec->mask & XANIME_PROP_BIT(XANIME_PROP_SCALE));
+}
+
+/********************************************************************************
+ * @brief: 判断属性是否为尺寸
+ * @param {uint8_t} prop
+ * @return {*}
+ ********************************************************************************/
+static bool prop_is_size(uint8_t prop)
+{
+    return prop == XANIME_PROP_WIDTH || prop == XANIME_PROP_HEIGHT;
+}
+
+/********************************************************************************
+ * @brief: 提交真实尺寸，作为之后缩放的基准，尺寸未变化时不触发布局
+ * @param {lv_obj_t*} obj
+ * @param {uint8_t} prop XANIME_PROP_WIDTH / XANIME_PROP_HEIGHT
+ * @param {int32_t} size
+ * @return {*}
+ ********************************************************************************/
+static void flip_commit(lv_obj_t *obj, uint8_t prop, int32_t size)
+{
+    // 尺寸为 0 时不能作为缩放基准，先保留当前尺寸，到达 0 时由回调直接修改
+    if (size <= 0)
+        size = prop_get_value(prop, obj);
+    if (prop == XANIME_PROP_WIDTH)
+    {
+        if (lv_obj_get_style_width(obj, LV_PART_MAIN) != size)
+            lv_obj_set_width(obj, size);
+        return;
+    }
+    if (lv_obj_get_style_height(obj, LV_PART_MAIN) != size)
+        lv_obj_set_height(obj, size);
+}
+
+/********************************************************************************
+ * @brief: 将尺寸通道转换为缩放变换，最终尺寸在开始时提交一次
+ * @param {lv_obj_t*} obj
+ * @param {uint8_t} prop XANIME_PROP_WIDTH / XANIME_PROP_HEIGHT
+ * @param {bool} is_from 反向播放，最终尺寸为当前尺寸
+ * @param {anim_channel_t*} ch
+ * @return {*}
+ ********************************************************************************/
+static void flip_channel(lv_obj_t *obj, uint8_t prop, bool is_from, anim_channel_t *ch)
+{
+    ch->exec_cb = prop == XANIME_PROP_WIDTH ? flip_width_exec_cb : flip_height_exec_cb;
+    flip_commit(obj, prop, is_from ? ch->start : ch->end);
+    // 立即按起始尺寸缩放显示，避免延迟期间显示为最终尺寸
+    if (!is_from)
+        ch->exec_cb(obj, ch->start);
+}
+
+/********************************************************************************
+ * @brief: 读取对象上属性的当前值
+ * @param {uint8_t} prop 可动画属性
+ * @param {lv_obj_t*} obj
+ * @return {*}
+ ********************************************************************************/
+static int32_t prop_get_value(uint8_t prop, lv_obj_t *obj)
+{
+    return prop < ANIM_PROP_COUNT && channel_table[prop].get ? channel_table[prop].get(obj) : 0;
+}
+
+/********************************************************************************
+ * @brief: 判断属性是否为颜色
+ * @param {uint8_t} prop
+ * @return {*}
+ ********************************************************************************/
+static bool prop_is_color(uint8_t prop)
+{
+    return prop < ANIM_PROP_COUNT && (channel_color_mask & XANIME_PROP_BIT(prop));
+}
+
+/********************************************************************************
+ * @brief: 判断属性是否接受百分比，几何属性按对象或父对象尺寸换算
+ * @param {uint8_t} prop
+ * @return {*}
+ ********************************************************************************/
+static bool prop_percent_ok(uint8_t prop)
+{
+    if (prop <= XANIME_PROP_HEIGHT || prop == XANIME_PROP_PIVOT_X || prop == XANIME_PROP_PIVOT_Y)
+        return true;
+    return prop < ANIM_PROP_COUNT && channel_table[prop].percent_ref != 0;
+}
+
+/********************************************************************************
+ * @brief: 属性名，用于错误输出
+ * @param {uint8_t} prop
+ * @return {*}
+ ********************************************************************************/
+static const char *prop_name(uint8_t prop)
+{
+    if (prop == XANIME_PROP_PIVOT_X)
+        return "pivot_x";
+    if (prop == XANIME_PROP_PIVOT_Y)
+        return "pivot_y";
+    if (prop < ANIM_PROP_COUNT && channel_table[prop].name)
+        return channel_table[prop].name;
+    return "channel";
+}
+
+/********************************************************************************
+ * @brief: 取出位图中最低的属性位
+ * @param {uint32_t*} mask 非 0，取出后清除该位
+ * @return {*} 属性索引
+ ********************************************************************************/
+static uint8_t mask_pop(uint32_t *mask)
+{
+#if defined(__GNUC__)
+    uint8_t prop = (uint8_t)__builtin_ctz(*mask);
+#else
+    uint8_t prop = 0;
+    while (!(*mask & XANIME_PROP_BIT(prop)))
+        prop++;
+#endif
+    *mask &= *mask - 1;
+    return prop;
+}
+
+/********************************************************************************
+ * @brief: 注册自定义动画通道，之后可以像内置属性一样用于所有驱动方式、关键帧与覆盖
+ * @param {xanime_channel_t*} channel 描述会被复制，name 需要一直有效
+ * @return {*} 分配的属性索引，失败时返回 XANIME_PROP_COUNT
+ ********************************************************************************/
+xanime_prop_t xanime_channel_register(const xanime_channel_t *channel)
+{
+    if (!channel || !channel->get || !channel->set || channel->invalidate > XANIME_INVALIDATE_LAYOUT)
+    {
+        printf("Error: Invalid channel descriptor\n");
+        return XANIME_PROP_COUNT;
+    }
+    if (channel_custom_num >= XANIME_CHANNEL_CUSTOM_NUM)
+    {
+        printf("Error: Too many custom channels, increase XANIME_CHANNEL_CUSTOM_NUM\n");
+        return XANIME_PROP_COUNT;
+    }
+    xanime_prop_t prop = (xanime_prop_t)(XANIME_PROP_CUSTOM + channel_custom_num++);
+    channel_table[prop] = *channel;
+    channel_kind_mask[channel->invalidate] |= XANIME_PROP_BIT(prop);
+    if (channel->type == XANIME_VALUE_COLOR)
+        channel_color_mask |= XANIME_PROP_BIT(prop);
+    return prop;
+}
+
+/********************************************************************************
+ * @brief: 获取属性的动画回调函数
+ * @param {uint8_t} prop 可动画属性
+ * @return {*}
+ ********************************************************************************/
+static lv_anim_exec_xcb_t prop_exec_cb(uint8_t prop)
+{
+    return prop < ANIM_PROP_COUNT ? channel_table[prop].set : NULL;
+}
+
+/********************************************************************************
+ * @brief: 设置旋转中心
+ * @param {xanime_t*} anime
+ * @param {lv_obj_t*} obj
+ * @param {geom_snapshot_t*} geom
+ * @return {*}
+ ********************************************************************************/
+static void apply_pivot(xanime_t *anime, lv_obj_t *obj, const geom_snapshot_t *geom)
+{
+    const xanime_spec_t *spec = &anime->spec;
+    uint32_t mask = spec->mask;
+
+    // pivot_x
+    if (mask & XANIME_PROP_BIT(XANIME_PROP_PIVOT_X))
+    {
+        if (is_image_object(obj))
+        {
+            lv_point_t pivot;
+            lv_img_get_pivot(obj, &pivot);
+            int32_t pivot_x = resolve_value(XANIME_PROP_PIVOT_X, geom, spec->values[XANIME_PROP_PIVOT_X], pivot.x);
+            lv_img_set_pivot(obj, pivot_x, pivot.y);
+        }
+        else
+        {
+            int32_t cur = lv_obj_get_style_transform_pivot_x(obj, LV_PART_MAIN);
+            int32_t pivot_x = resolve_value(XANIME_PROP_PIVOT_X, geom, spec->values[XANIME_PROP_PIVOT_X], cur);
+            lv_obj_set_style_transform_pivot_x(obj, pivot_x, LV_PART_MAIN);
+        }
+    }
+    // pivot_y
+    if (mask & XANIME_PROP_BIT(XANIME_PROP_PIVOT_Y))
+    {
+        if (is_image_object(obj))
+        {
+            lv_point_t pivot;
+            lv_img_get_pivot(obj, &pivot);
+            int32_t pivot_y = resolve_value(XANIME_PROP_PIVOT_Y, geom, spec->values[XANIME_PROP_PIVOT_Y], pivot.y);
+            lv_img_set_pivot(obj, pivot.x, pivot_y);
+        }
+        else
+        {
+            int32_t cur = lv_obj_get_style_transform_pivot_y(obj, LV_PART_MAIN);
+            int32_t pivot_y = resolve_value(XANIME_PROP_PIVOT_Y, geom, spec->values[XANIME_PROP_PIVOT_Y], cur);
+            lv_obj_set_style_transform_pivot_y(obj, pivot_y, LV_PART_MAIN);
+        }
+    }
+}
+
+/********************************************************************************
+ * @brief: 启动融合动画，一个 lv_anim 驱动对象的所有属性通道
+ * @param {lv_anim_t*} anim
+ * @param {xanime_t*} anime
+ * @param {anim_channel_t*} ch
+ * @param {uint8_t} ch_num
+ * @return {*}
+ ********************************************************************************/
+static void fused_start(lv_anim_t *anim, xanime_t *anime, const anim_channel_t *ch, uint8_t ch_num)
+{
+    // 通道数据紧跟在结构体之后
+    fused_anim_t *fa = pool_alloc(XANIME_POOL_DATA, sizeof(fused_anim_t) +
+                                                        ch_num * (sizeof(lv_anim_exec_xcb_t) + 3 * sizeof(int32_t)));
+    if (!fa)
+        return;
+    lv_obj_t *obj = anim->var;
+    fa->exec_cb = (lv_anim_exec_xcb_t *)(fa + 1);
+    fa->start = (int32_t *)(fa->exec_cb + ch_num);
+    fa->end = fa->start + ch_num;
+    fa->last = fa->end + ch_num;
+    fa->color_mask = 0;
+    fa->path = ANIME_PRIV(anime)->path_lut ? path_lut_ref(ANIME_PRIV(anime)->path_lut) : NULL;
+    memset(fa->path_ch, UINT8_MAX, sizeof(fa->path_ch));
+
+    fa->slot = anime_slot_take(anime);
+    fa->complete_cb = anime->spec.complete_cb;
+    fa->user_data = anime->spec.user_data;
+    fa->ch_num = ch_num;
+    fa->wide = false;
+    fa->cached = false;
+    fa->threshold = anime->spec.threshold;
+    fa->cullable = spec_cullable(&anime->spec);
+    fa->culled = false;
+    fa->cull_tick = lv_tick_get() - XANIME_CULL_PERIOD;
+    fa->priority = anime->spec.priority;
+    fa->sched_cnt = 0;
+    fa->interval = fps_interval(anime->spec.fps);
+    fa->write_tick = lv_tick_get() - fa->interval;
+    fa->round = 0;
+    fa->act_last = 0;
+    sched_attach();
+    for (uint8_t i = 0; i < ch_num; i++)
+    {
+        fa->exec_cb[i] = ch[i].exec_cb;
+        fa->start[i] = anime->spec.is_from ? ch[i].end : ch[i].start;
+        fa->end[i] = anime->spec.is_from ? ch[i].start : ch[i].end;
+        uint8_t axis = fa->path ? path_axis(&anime->spec, ch[i].prop) : PATH_AXIS_NONE;
+        if (axis != PATH_AXIS_NONE)
+            fa->path_ch[axis] = i;
+        if (prop_is_color(ch[i].prop))
+            fa->color_mask |= (uint32_t)1 << i;
+        else if (!lerp_is_narrow(fa->start[i], fa->end[i]))
+            fa->wide = true;
+    }
+
+    // var 为目标对象 (或其快照)，删除对象时 LVGL 会一并删除该动画
+    fa->snap.proxy = NULL;
+    fa->snap.sprite = NULL;
+    if (spec_snapshot(&anime->spec))
+        lv_anim_set_var(anim, snapshot_begin(&fa->snap, anim->var, anime->spec.snapshot, anime->spec.sprite_frames));
+#if LV_USE_CANVAS
+    // 旋转帧只切换帧
+    for (uint8_t i = 0; fa->snap.sprite && i < ch_num; i++)
+    {
+        if (fa->exec_cb[i] == rotate_exec_cb)
+            fa->exec_cb[i] = sprite_exec_cb;
+    }
+#endif
+    lv_anim_set_custom_exec_cb(anim, fused_exec_cb);
+    lv_anim_set_values(anim, 0, XANIME_PROGRESS_MAX);
+    lv_anim_set_user_data(anim, fa);
+    lv_anim_set_ready_cb(anim, fused_ready_cb);
+    lv_anim_set_deleted_cb(anim, fused_deleted_cb);
+    fa->claims = NULL;
+    fa->claim_live = 0;
+    fa->anim = lv_anim_start(anim);
+    anime_slot_bind(fa->slot, fa->anim);
+    if (!fa->anim || anime->spec.overwrite == XANIME_OVERWRITE_NONE)
+        return;
+
+    // 登记到覆盖索引，记录分配失败时不参与覆盖
+    fa->claims = XANIME_MALLOC(ch_num * sizeof(claim_t));
+    if (!fa->claims)
+        return;
+    for (uint8_t i = 0; i < ch_num; i++)
+    {
+        claim_t *claim = &fa->claims[i];
+        claim->obj = obj;
+        claim->runner = fa;
+        claim->prop = ch[i].prop;
+        claim->is_group = false;
+        claim->live = true;
+        claim_insert(claim);
+    }
+    fa->claim_live = ch_num;
+}
+
+/********************************************************************************
+ * @brief: 融合动画回调函数，v 为缓动后的进度
+ * @param {lv_anim_t*} a
+ * @param {int32_t} v
+ * @return {*}
+ ********************************************************************************/
+static void fused_exec_cb(lv_anim_t *a, int32_t v)
+{
+    fused_anim_t *fa = a->user_data;
+    xanime_t *owner = fa->slot ? fa->slot->owner : NULL;
+    // 错开的对象在不同帧重复，控制器只在第一个对象进入新的一轮时派发
+    if (a->act_time < fa->act_last && owner && ++fa->round > ANIME_PRIV(owner)->event_round)
+    {
+        ANIME_PRIV(owner)->event_round = fa->round;
+        anime_emit(owner, XANIME_EVENT_REPEAT);
+    }
+    fa->act_last = a->act_time;
+    // 不可见时不写样式，lv_anim 的时间照常推进，重新可见后直接写入当前值；最后一帧总是写入
+    bool last_frame = a->act_time >= (int32_t)a->duration;
+    if (fa->cullable && !last_frame)
+    {
+        if (cull_due(fa->cull_tick))
+        {
+            fa->cull_tick = lv_tick_get();
+            fa->culled = obj_culled(fa->snap.proxy ? fa->snap.obj : a->var);
+        }
+        if (fa->culled)
+            return;
+    }
+    // 负载过高时低优先级动画隔帧写入
+    uint32_t div = sched_divider(fa->priority);
+    if (div > 1 && !last_frame && ++fa->sched_cnt % div != 0)
+        return;
+    // 限制帧率时未到间隔不写入
+    if (fa->interval && !last_frame)
+    {
+        if (lv_tick_elaps(fa->write_tick) < fa->interval)
+            return;
+        fa->write_tick = lv_tick_get();
+    }
+    int32_t values[ANIM_PROP_COUNT];
+    // 打包颜色的差值超出 32 位插值的范围，以 0 差值参与批量插值，之后按分量重新计算
+    const int32_t *end = fa->end;
+    int32_t color_end[ANIM_PROP_COUNT];
+    if (fa->color_mask)
+    {
+        memcpy(color_end, fa->end, fa->ch_num * sizeof(int32_t));
+        for (uint32_t mask = fa->color_mask; mask;)
+        {
+            uint8_t i = mask_pop(&mask);
+            color_end[i] = fa->start[i];
+        }
+        end = color_end;
+    }
+    if (fa->wide)
+        lerp_batch_wide(fa->start, end, values, fa->ch_num, v);
+    else
+        lerp_batch(fa->start, end, values, fa->ch_num, v);
+    // 颜色通道按分量插值
+    for (uint32_t mask = fa->color_mask; mask;)
+    {
+        uint8_t i = mask_pop(&mask);
+        values[i] = lerp_color(fa->start[i], fa->end[i], v);
+    }
+    // 路径通道按弧长查表，相对路径以开始时的位置 (反向播放为终点) 为原点
+    for (uint8_t axis = 0; fa->path && axis < PATH_AXIS_NUM; axis++)
+    {
+        uint8_t i = fa->path_ch[axis];
+        if (i != UINT8_MAX)
+            values[i] = path_value(fa->path, axis, v, fa->path->reverse ? fa->end[i] : fa->start[i]);
+    }
+
+    // 缓动进度变化时单个通道的值不一定变化，未变化的通道不写样式也不触发重绘
+    uint32_t skipped = 0;
+    for (uint8_t i = 0; i < fa->ch_num; i++)
+    {
+        // 被其他动画覆盖的通道
+        if (fa->claims && !fa->claims[i].live)
+            continue;
+        bool at_key = values[i] == fa->start[i] || values[i] == fa->end[i];
+        // 打包的颜色不能按数值差比较阈值
+        uint8_t threshold = fa->color_mask & ((uint32_t)1 << i) ? 0 : fa->threshold;
+        if (fa->cached && write_skippable(fa->last[i], values[i], at_key, threshold))
+        {
+            skipped++;
+            continue;
+        }
+        fa->last[i] = values[i];
+        fa->exec_cb[i](a->var, values[i]);
+    }
+    fa->cached = true;
+    anime_emit(owner, XANIME_EVENT_UPDATE);
+    if (skipped && fa->slot)
+        ANIME_PRIV(fa->slot->owner)->skip_cnt += skipped;
+}
+
+/********************************************************************************
+ * @brief: 判断本次写入能否跳过
+ * @param {int32_t} last 上次写入的值
+ * @param {int32_t} v 本次的值
+ * @param {bool} at_key 本次的值为段的起止值，不按阈值跳过，保证停在精确的关键帧上
+ * @param {uint8_t} threshold 变化阈值
+ * @return {*}
+ ********************************************************************************/
+static bool write_skippable(int32_t last, int32_t v, bool at_key, uint8_t threshold)
+{
+    if (v == last)
+        return true;
+    if (at_key || threshold <= 1)
+        return false;
+    int64_t diff = (int64_t)v - last;
+    return diff < threshold && diff > -(int64_t)threshold;
+}
+
+/********************************************************************************
+ * @brief: 判断动画能否剔除不可见对象，位置与尺寸动画可能让对象重新进入显示区域，不剔除
+ * @param {xanime_spec_t*} spec
+ * @return {*}
+ ********************************************************************************/
+static bool spec_cullable(const xanime_spec_t *spec)
+{
+#if XANIME_CULL_ENABLE
+    return !(spec->mask & channel_kind_mask[XANIME_INVALIDATE_LAYOUT]);
+#else
+    LV_UNUSED(spec);
+    return false;
+#endif
+}
+
+/********************************************************************************
+ * @brief: 判断对象是否不可见: 自身或父对象隐藏、在父对象的显示区域之外、不在活动屏幕上
+ * @param {lv_obj_t*} obj
+ * @return {*}
+ ********************************************************************************/
+static bool obj_culled(lv_obj_t *obj)
+{
+    return lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) || !lv_obj_is_visible(obj);
+}
+
+/********************************************************************************
+ * @brief: 判断是否需要重新检测可见性
+ * @param {uint32_t} cull_tick 上次检测的 tick
+ * @return {*}
+ ********************************************************************************/
+static bool cull_due(uint32_t cull_tick)
+{
+#if XANIME_CULL_PERIOD > 0
+    return lv_tick_elaps(cull_tick) >= XANIME_CULL_PERIOD;
+#else
+    LV_UNUSED(cull_tick);
+    return true;
+#endif
+}
+
+/********************************************************************************
+ * @brief: 判断起止值能否使用 32 位批量插值
+ * @param {int32_t} from
+ * @param {int32_t} to
+ * @return {*}
+ ********************************************************************************/
+static bool lerp_is_narrow(int32_t from, int32_t to)
+{
+    int64_t diff = (int64_t)to - from;
+    return diff >= -LERP_NARROW_MAX && diff <= LERP_NARROW_MAX;
+}
+
+/********************************************************************************
+ * @brief: 批量插值 out[i] = from[i] + ((to[i] - from[i]) * progress >> 10)
+ *         所有对象共用一个进度，要求 |to[i] - from[i]| <= LERP_NARROW_MAX，各实现结果逐位一致
+ * @param {int32_t*} from
+ * @param {int32_t*} to
+ * @param {int32_t*} out
+ * @param {uint32_t} n
+ * @param {int32_t} progress 缓动后的进度，XANIME_PROGRESS_MAX 为终点
+ * @return {*}
+ ********************************************************************************/
+static void lerp_batch(const int32_t *from, const int32_t *to, int32_t *out, uint32_t n, int32_t progress)
+{
+    uint32_t i = 0;
+#if defined(LERP_AVX2)
+    __m256i p8 = _mm256_set1_epi32(progress);
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i f = _mm256_loadu_si256((const __m256i *)(from + i));
+        __m256i d = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i *)(to + i)), f);
+        d = _mm256_srai_epi32(_mm256_mullo_epi32(d, p8), XANIME_PROGRESS_SHIFT);
+        _mm256_storeu_si256((__m256i *)(out + i), _mm256_add_epi32(f, d));
+    }
+#elif defined(LERP_SSE2)
+    // SSE2 没有 32 位低位乘法，用两次 32x32->64 无符号乘法取低 32 位，与有符号乘法的低位相同
+    __m128i p4 = _mm_set1_epi32(progress);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i f = _mm_loadu_si128((const __m128i *)(from + i));
+        __m128i d = _mm_sub_epi32(_mm_loadu_si128((const __m128i *)(to + i)), f);
+        __m128i even = _mm_mul_epu32(d, p4);
+        __m128i odd = _mm_mul_epu32(_mm_srli_si128(d, 4), p4);
+        __m128i mul = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                         _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+        _mm_storeu_si128((__m128i *)(out + i), _mm_add_epi32(f, _mm_srai_epi32(mul, XANIME_PROGRESS_SHIFT)));
+    }
+#elif defined(LERP_NEON)
+    int32x4_t p4 = vdupq_n_s32(progress);
+    for (; i + 4 <= n; i += 4)
+    {
+        int32x4_t f = vld1q_s32(from + i);
+        int32x4_t d = vsubq_s32(vld1q_s32(to + i), f);
+        d = vshrq_n_s32(vmulq_s32(d, p4), XANIME_PROGRESS_SHIFT);
+        vst1q_s32(out + i, vaddq_s32(f, d));
+    }
+#endif
+    // 标量实现，同时处理 SIMD 剩余的元素
+    for (; i < n; i++)
+    {
+        out[i] = from[i] + (((to[i] - from[i]) * progress) >> XANIME_PROGRESS_SHIFT);
+    }
+}
+
+/********************************************************************************
+ * @brief: 64 位批量插值，用于超出 LERP_NARROW_MAX 的起止值
+ * @param {int32_t*} from
+ * @param {int32_t*} to
+ * @param {int32_t*} out
+ * @param {uint32_t} n
+ * @param {int32_t} progress
+ * @return {*}
+ ********************************************************************************/
+static void lerp_batch_wide(const int32_t *from, const int32_t *to, int32_t *out, uint32_t n, int32_t progress)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        // 在 64 位中加上起点，差值接近 32 位范围时中间结果不会溢出
+        out[i] = (int32_t)(from[i] + ((((int64_t)to[i] - from[i]) * progress) >> XANIME_PROGRESS_SHIFT));
+    }
+}
+
+/********************************************************************************
+ * @brief: 0xRRGGBB 颜色按分量插值，回弹类缓动超出的部分截断到 [0, 255]
+ * @param {int32_t} from
+ * @param {int32_t} to
+ * @param {int32_t} progress
+ * @return {*}
+ ********************************************************************************/
+static int32_t lerp_color(int32_t from, int32_t to, int32_t progress)
+{
+    int32_t out = 0;
+    for (uint8_t shift = 0; shift <= 16; shift += 8)
+    {
+        int32_t a = (from >> shift) & 0xFF;
+        int32_t b = (to >> shift) & 0xFF;
+        int32_t c = a + (((b - a) * progress) >> XANIME_PROGRESS_SHIFT);
+        out |= LV_CLAMP(0, c, 0xFF) << shift;
+    }
+    return out;
+}
+
+/********************************************************************************
+ * @brief: 批量颜色插值
+ * @param {int32_t*} from
+ * @param {int32_t*} to
+ * @param {int32_t*} out
+ * @param {uint32_t} n
+ * @param {int32_t} progress
+ * @return {*}
+ ********************************************************************************/
+static void lerp_color_batch(const int32_t *from, const int32_t *to, int32_t *out, uint32_t n, int32_t progress)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        out[i] = lerp_color(from[i], to[i], progress);
+    }
+}
+
+/********************************************************************************
+ * @brief: 融合动画完成回调，还原用户数据后调用用户回调
+ * @param {lv_anim_t*} a
+ * @return {*}
+ ********************************************************************************/
+static void fused_ready_cb(lv_anim_t *a)
+{
+    fused_anim_t *fa = a->user_data;
+    // 已结束的动画不再参与覆盖，回调中启动的新动画不会找到它
+    for (uint8_t i = 0; fa->claims && i < fa->ch_num; i++)
+        claim_remove(&fa->claims[i]);
+    // 最后一个 lv_anim 完成时控制器完成，记录在删除回调中才释放
+    if (fa->slot && ANIME_PRIV(fa->slot->owner)->slot_live == 1)
+        anime_emit(fa->slot->owner, XANIME_EVENT_COMPLETE);
+    // 结束时把最终状态还给原对象，回调中看到的是原对象
+    lv_obj_t *obj = fa->snap.proxy ? fa->snap.obj : a->var;
+    snapshot_end(&fa->snap);
+    if (!fa->complete_cb)
+        return;
+    lv_anim_t user_anim = *a;
+    user_anim.var = obj;
+    user_anim.user_data = fa->user_data;
+    fa->complete_cb(&user_anim);
+}
+
+/********************************************************************************
+ * @brief: 融合动画删除回调，释放通道表
+ * @param {lv_anim_t*} a
+ * @return {*}
+ ********************************************************************************/
+static void fused_deleted_cb(lv_anim_t *a)
+{
+    fused_anim_t *fa = a->user_data;
+    snapshot_end(&fa->snap);
+    if (fa->claims)
+    {
+        for (uint8_t i = 0; i < fa->ch_num; i++)
+            claim_remove(&fa->claims[i]);
+        XANIME_FREE(fa->claims);
+    }
+    anime_slot_release(fa->slot);
+    path_lut_put(fa->path);
+    pool_free(XANIME_POOL_DATA, fa);
+    a->user_data = NULL;
+}
+
+/********************************************************************************
+ * @brief: 判断动画描述中是否有关键帧轨道
+ * @param {xanime_spec_t*} spec
+ * @return {*}
+ ********************************************************************************/
+static bool spec_has_tracks(const xanime_spec_t *spec)
+{
+    for (uint8_t prop = 0; prop < ANIM_PROP_COUNT; prop++)
+    {
+        if (spec->tracks[prop].num > 0)
+            return true;
+    }
+    return false;
+}
+
+/********************************************************************************
+ * @brief: 判断动画是否由组动画驱动：组模式、关键帧轨道与弹簧
+ * @param {xanime_spec_t*} spec
+ * @return {*}
+ ********************************************************************************/
+static bool spec_grouped(const xanime_spec_t *spec)
+{
+    return spec->mode == XANIME_MODE_GROUP || spec->is_spring || spec_has_tracks(spec);
+}
+
+/********************************************************************************
+ * @brief: 属性模式每个属性一个 lv_anim，快照动画与按帧派发事件需要每个对象只有一个 lv_anim，
+ *         颜色与路径不是线性插值，这些情况改为融合模式
+ * @param {xanime_spec_t*} spec
+ * @return {*}
+ ********************************************************************************/
+static void spec_resolve_mode(xanime_spec_t *spec)
+{
+    if (spec->mode == XANIME_MODE_PROPERTY &&
+        (spec_snapshot(spec) || spec->event_cb || (spec->mask & channel_color_mask) || spec->path))
+        spec->mode = XANIME_MODE_FUSED;
+}
+
+/********************************************************************************
+ * @brief: 属性使用的关键帧轨道，弹簧只使用起止值
+ * @param {xanime_spec_t*} spec
+ * @param {uint8_t} prop
+ * @return {*}
+ ********************************************************************************/
+static const xanime_track_t *spec_track(const xanime_spec_t *spec, uint8_t prop)
+{
+    static const xanime_track_t empty = {NULL, 0};
+    return spec->is_spring ? &empty : &spec->tracks[prop];
+}
+
+/********************************************************************************
+ * @brief: 轨道展开后的关键帧数量，第一帧不在 0 时刻时补一个当前值关键帧
+ * @param {xanime_track_t*} track
+ * @return {*}
+ ********************************************************************************/
+static uint16_t track_kf_num(const xanime_track_t *track)
+{
+    uint16_t kf_num = track->num;
+    if (track->frames[0].time > 0)
+        kf_num++;
+    // 至少构成一段
+    return kf_num < 2 ? 2 : kf_num;
+}
+
+/********************************************************************************
+ * @brief: 展开后的第 k 个关键帧对应的用户关键帧
+ * @param {xanime_track_t*} track
+ * @param {uint16_t} k
+ * @return {*} 补充的当前值关键帧返回 NULL
+ ********************************************************************************/
+static const xanime_keyframe_t *track_frame(const xanime_track_t *track, uint16_t k)
+{
+    if (track->frames[0].time > 0)
+    {
+        if (k == 0)
+            return NULL;
+        k--;
+    }
+    return &track->frames[k < track->num ? k : track->num - 1];
+}
+
+/********************************************************************************
+ * @brief: 启动组动画，解析所有对象的关键帧值并注册到驱动
+ * @param {xanime_t*} anime
+ * @param {bool} need_geom 是否需要几何快照
+ * @return {*}
+ ********************************************************************************/
+static group_anim_t *group_start(xanime_t *anime, bool need_geom)
+{
+    group_anim_t *g = group_build(anime, need_geom);
+    if (!g)
+        return NULL;
+
+    // 立即应用起始值
+    group_capture(g);
+    group_seek(g, 0);
+    group_play(g);
+    return g;
+}
+
+/********************************************************************************
+ * @brief: 将组动画注册到驱动，已注册时不重复添加
+ * @param {group_anim_t*} g
+ * @return {*}
+ ********************************************************************************/
+static void group_play(group_anim_t *g)
+{
+    if (g->active)
+        return;
+    g->active = true;
+    // 开始后第一帧立即检测可见性
+    g->cull_tick = lv_tick_get() - XANIME_CULL_PERIOD;
+    group_snapshot(g, true);
+    driver_add(&g->node);
+}
+
+/********************************************************************************
+ * @brief: 为组内所有对象开始或结束快照，暂停时保留快照
+ * @param {group_anim_t*} g
+ * @param {bool} begin
+ * @return {*}
+ ********************************************************************************/
+static void group_snapshot(group_anim_t *g, bool begin)
+{
+    if (!g->snaps)
+        return;
+    for (uint16_t i = 0; i < g->obj_num; i++)
+    {
+        if (!begin)
+            snapshot_end(&g->snaps[i]);
+        else if (g->objs[i] && !g->snaps[i].proxy)
+            snapshot_begin(&g->snaps[i], g->objs[i], g->snap_bitmap, g->sprite_frames);
+    }
+}
+
+/********************************************************************************
+ * @brief: 将组动画从驱动中移除，保留当前进度
+ * @param {group_anim_t*} g
+ * @return {*}
+ ********************************************************************************/
+static void group_stop(group_anim_t *g)
+{
+    if (!g->active)
+        return;
+    g->active = false;
+    driver_remove(&g->node);
+}
+
+/********************************************************************************
+ * @brief: 构建组动画，完成分配、百分比与关键帧解析，相对值留到开始时确定
+ * @param {xanime_t*} anime
+ * @param {bool} need_geom 是否需要几何快照
+ * @return {*}
+ ********************************************************************************/
+static group_anim_t *group_build(xanime_t *anime, bool need_geom)
+{
+    const xanime_spec_t *spec = &anime->spec;
+    uint16_t obj_num = anime->obj.obj_num;
+
+    // 普通属性为两个关键帧: 当前值 -> 目标值
+    uint8_t props[ANIM_PROP_COUNT];
+    uint16_t kf_nums[ANIM_PROP_COUNT];
+    uint8_t ch_num = 0;
+    size_t kf_total = 0;
+    for (uint32_t mask = spec->mask & (XANIME_PROP_BIT(ANIM_PROP_COUNT) - 1); mask;)
+    {
+        uint8_t prop = mask_pop(&mask);
+        props[ch_num] = prop;
+        kf_nums[ch_num] = spec_track(spec, prop)->num > 0 ? track_kf_num(spec_track(spec, prop)) : 2;
+        kf_total += kf_nums[ch_num];
+        ch_num++;
+    }
+
+    // 控制器、对象数组、通道与关键帧数据一次分配
+    size_t snap_num = spec_snapshot(spec) ? obj_num : 0;
+    size_t stagger_num = spec->stagger > 0 && obj_num > 1 ? obj_num : 0;
+    size_t spring_num = spec->is_spring ? (size_t)ch_num * obj_num : 0;
+    size_t size = sizeof(group_anim_t) + obj_num * sizeof(lv_obj_t *) + ch_num * sizeof(group_channel_t) +
+                  snap_num * sizeof(snapshot_t) + spring_num * 2 * sizeof(int64_t) +
+                  (kf_total + 1 + ch_num) * obj_num * sizeof(int32_t) +
+                  (kf_total + stagger_num) * sizeof(uint32_t) + kf_total * 2 * sizeof(uint8_t) +
+                  obj_num * sizeof(uint8_t);
+    group_anim_t *g = pool_alloc(XANIME_POOL_DATA, size);
+    if (!g)
+        return NULL;
+    memset(g, 0, sizeof(group_anim_t));
+    g->node.advance = group_advance;
+    g->node.finish = group_finish;
+    g->objs = (lv_obj_t **)(g + 1);
+    g->ch = (group_channel_t *)(g->objs + obj_num);
+    g->obj_num = obj_num;
+    g->ch_num = ch_num;
+
+    g->snaps = snap_num ? (snapshot_t *)(g->ch + ch_num) : NULL;
+    memset(g->ch + ch_num, 0, snap_num * sizeof(snapshot_t));
+    uint8_t *tail = (uint8_t *)(g->ch + ch_num) + snap_num * sizeof(snapshot_t);
+    g->spring_pos = spring_num ? (int64_t *)tail : NULL;
+    g->spring_vel = spring_num ? g->spring_pos + spring_num : NULL;
+    g->scratch = (int32_t *)(tail + spring_num * 2 * sizeof(int64_t));
+    int32_t *values = g->scratch + obj_num;
+    // 已删除的对象不解析，数值保持为 0
+    memset(values, 0, kf_total * obj_num * sizeof(int32_t));
+    int32_t *last = values + kf_total * obj_num;
+    uint32_t *times = (uint32_t *)(last + (size_t)ch_num * obj_num);
+    g->offsets = stagger_num ? times + kf_total : NULL;
+    uint8_t *easings = (uint8_t *)(times + kf_total + stagger_num);
+    uint8_t *rel = easings + kf_total;
+    g->culled = spec_cullable(spec) ? rel + kf_total : NULL;
+    for (uint8_t c = 0; c < ch_num; c++)
+    {
+        const xanime_track_t *track = spec_track(spec, props[c]);
+        group_channel_t *ch = &g->ch[c];
+        ch->path_axis = ANIME_PRIV(anime)->path_lut ? path_axis(spec, props[c]) : PATH_AXIS_NONE;
+        // 弹簧的目标值可以随时改变，直接写入属性
+        ch->translate = spec->use_translate && prop_is_position(props[c]) && ch->path_axis == PATH_AXIS_NONE &&
+                        !spec->is_spring;
+        // 错开的对象各自处于不同的段，不能共用提交真实尺寸的关键帧
+        ch->flip = spec_flip_size(spec) && prop_is_size(props[c]) && !g->offsets && !spec->is_spring;
+        ch->flip_key = UINT16_MAX;
+        if (ch->translate)
+            ch->exec_cb = props[c] == XANIME_PROP_X ? translate_x_exec_cb : translate_y_exec_cb;
+        else if (ch->flip)
+            ch->exec_cb = props[c] == XANIME_PROP_WIDTH ? flip_width_exec_cb : flip_height_exec_cb;
+        else
+            ch->exec_cb = prop_exec_cb(props[c]);
+        ch->prop = props[c];
+        ch->kf_num = kf_nums[c];
+        ch->seg = 0;
+        ch->wide = false;
+        ch->color = prop_is_color(props[c]);
+        ch->times = times;
+        ch->easings = easings;
+        ch->rel = rel;
+        ch->values = values;
+        ch->last = last + (size_t)c * obj_num;
+        times += ch->kf_num;
+        easings += ch->kf_num;
+        rel += ch->kf_num;
+        values += (size_t)ch->kf_num * obj_num;
+
+        if (track->num == 0)
+        {
+            ch->times[0] = 0;
+            ch->times[1] = spec->dur;
+            ch->easings[0] = ease_normalize(spec->easing);
+            ch->easings[1] = ease_normalize(spec->easing);
+            ch->rel[0] = 1;
+            ch->rel[1] = spec->values[props[c]].unit == XANIME_UNIT_REL;
+            continue;
+        }
+        for (uint16_t k = 0; k < ch->kf_num; k++)
+        {
+            // 补充的 0 时刻关键帧等价于 "+=0"
+            const xanime_keyframe_t *frame = track_frame(track, k);
+            ch->times[k] = frame ? frame->time : 0;
+            ch->easings[k] = ease_normalize(frame ? frame->easing : spec->easing);
+            ch->rel[k] = !frame || frame->value.unit == XANIME_UNIT_REL;
+        }
+    }
+
+    // 错开时间只在构建时计算一次，重新播放直接复用
+    for (uint16_t i = 0; g->offsets && i < obj_num; i++)
+    {
+        g->offsets[i] = stagger_offset(spec, i, obj_num);
+        if (g->offsets[i] > g->stagger)
+            g->stagger = g->offsets[i];
+    }
+
+    geom_snapshot_t geom = {0};
+    for (uint16_t i = 0; i < obj_num; i++)
+    {
+        lv_obj_t *cur_obj = anime->obj.obj_arr[i];
+        g->objs[i] = cur_obj;
+        // 已删除的对象
+        if (!cur_obj)
+            continue;
+        g->obj_live++;
+        if (need_geom)
+            geom_snapshot(&geom, cur_obj);
+        apply_pivot(anime, cur_obj, &geom);
+
+        for (uint8_t c = 0; c < ch_num; c++)
+        {
+            const xanime_track_t *track = spec_track(spec, props[c]);
+            group_channel_t *ch = &g->ch[c];
+            int32_t *kf_values = ch->values + i;
+
+            for (uint16_t k = 0; k < ch->kf_num; k++)
+            {
+                xanime_value_t value;
+                if (track->num == 0)
+                    value = k == 0 ? XANIME_REL(0) : spec->values[props[c]];
+                else
+                {
+                    const xanime_keyframe_t *frame = track_frame(track, k);
+                    value = frame ? frame->value : XANIME_REL(0);
+                }
+                // 相对值此时只记录增量
+                kf_values[(size_t)k * obj_num] = resolve_value(props[c], &geom, value, 0);
+            }
+        }
+
+        // 对象删除时从组中移除
+        lv_obj_add_event_cb(cur_obj, group_obj_delete_cb, LV_EVENT_DELETE, g);
+    }
+
+    g->is_from = spec->is_from;
+    g->dur = spec->dur;
+    g->delay = spec->delay;
+    g->repeat_cnt = spec->loop < 0 ? LV_ANIM_REPEAT_INFINITE : (spec->loop == 0 ? 1 : (uint32_t)spec->loop);
+    g->timescale = XANIME_TIMESCALE_NORMAL;
+    g->threshold = spec->threshold;
+    g->node.priority = spec->priority;
+    g->node.interval = fps_interval(spec->fps);
+    g->node.idle = group_idle;
+    g->snap_bitmap = spec->snapshot;
+    g->sprite_frames = spec->sprite_frames;
+    g->complete_cb = spec->complete_cb;
+    g->user_data = spec->user_data;
+    g->path = ANIME_PRIV(anime)->path_lut ? path_lut_ref(ANIME_PRIV(anime)->path_lut) : NULL;
+    if (spec->is_spring)
+    {
+        g->spring = spec->spring;
+        g->spring_step = spring_step(&spec->spring);
+    }
+
+    return g;
+}
+
+/********************************************************************************
+ * @brief: 读取对象的当前值，确定相对关键帧，只在第一次开始时执行
+ * @param {group_anim_t*} g
+ * @return {*}
+ ********************************************************************************/
+static void group_capture(group_anim_t *g)
+{
+    if (g->captured)
+        return;
+    g->captured = true;
+
+    uint16_t obj_num = g->obj_num;
+    for (uint8_t c = 0; c < g->ch_num; c++)
+    {
+        group_channel_t *ch = &g->ch[c];
+        for (uint16_t i = 0; i < obj_num; i++)
+        {
+            if (!g->objs[i])
+                continue;
+            int32_t cur = prop_get_value(ch->prop, g->objs[i]);
+            for (uint16_t k = 0; k < ch->kf_num; k++)
+            {
+                if (ch->rel[k])
+                    ch->values[(size_t)k * obj_num + i] += cur;
+                // 起止值确定后检查每段能否使用 32 位批量插值
+                if (k > 0 && !ch->color &&
+                    !lerp_is_narrow(ch->values[(size_t)(k - 1) * obj_num + i], ch->values[(size_t)k * obj_num + i]))
+                    ch->wide = true;
+            }
+        }
+
+        // 反向播放，关键帧值倒序
+        for (uint16_t k = 0; g->is_from && k < ch->kf_num / 2; k++)
+        {
+            int32_t *a = &ch->values[(size_t)k * obj_num];
+            int32_t *b = &ch->values[(size_t)(ch->kf_num - 1 - k) * obj_num];
+            for (uint16_t i = 0; i < obj_num; i++)
+            {
+                int32_t tmp = a[i];
+                a[i] = b[i];
+                b[i] = tmp;
+            }
+        }
+
+        if (ch->translate)
+            group_translate_channel(g, ch);
+    }
+    if (g->spring_pos)
+        group_spring_reset(g);
+}
+
+/********************************************************************************
+ * @brief: 提交位置通道的终点坐标，关键帧值转换为相对终点的 translate 偏移
+ * @param {group_anim_t*} g
+ * @param {group_channel_t*} ch
+ * @return {*}
+ ********************************************************************************/
+static void group_translate_channel(group_anim_t *g, group_channel_t *ch)
+{
+    uint16_t obj_num = g->obj_num;
+    const int32_t *final = ch->values + (size_t)(ch->kf_num - 1) * obj_num;
+    for (uint16_t i = 0; i < obj_num; i++)
+    {
+        if (!g->objs[i])
+            continue;
+        // 反向播放的终点即当前位置，不会触发布局
+        int32_t end = final[i];
+        int32_t base = translate_commit(g->objs[i], ch->prop, end, prop_get_value(ch->prop, g->objs[i]));
+        for (uint16_t k = 0; k < ch->kf_num; k++)
+            ch->values[(size_t)k * obj_num + i] += base - end;
+    }
+}
+
+/********************************************************************************
+ * @brief: 按 elapsed 计算延迟、循环与轮内时间，并应用到所有对象
+ * @param {group_anim_t*} g
+ * @return {*} 动画结束时返回 true
+ ********************************************************************************/
+static bool group_update(group_anim_t *g)
+{
+    if (g->spring_pos)
+        return group_update_spring(g);
+    bool infinite = g->repeat_cnt == LV_ANIM_REPEAT_INFINITE;
+    // 反向播放回到起点，无限循环在所有错开的对象都开始后的位置回绕
+    uint32_t base = g->delay + (infinite ? g->stagger : 0);
+    if (g->reversed && g->elapsed <= base)
+    {
+        if (!infinite)
+        {
+            g->elapsed = g->delay;
+            group_seek(g, 0);
+            return true;
+        }
+        // 无限循环反向回绕到上一轮
+        g->elapsed = base + g->dur - (base - g->elapsed) % g->dur;
+    }
+    if (g->elapsed < g->delay)
+        return false;
+
+    uint32_t t = g->elapsed - g->delay;
+    if (!infinite && (uint64_t)t >= (uint64_t)g->dur * g->repeat_cnt + g->stagger)
+    {
+        // 停在终点，反向播放从终点开始
+        g->elapsed = group_span(g);
+        group_seek(g, g->dur);
+        return !g->reversed;
+    }
+    if (g->offsets)
+        return group_update_stagger(g, t);
+
+    uint32_t loop_idx = t / g->dur;
+    if (loop_idx != g->loop_idx)
+    {
+        // 新的一轮从第一段开始，反向播放从最后一段开始，不需要查找
+        for (uint8_t c = 0; c < g->ch_num; c++)
+            g->ch[c].seg = g->reversed ? g->ch[c].kf_num - 2 : 0;
+        g->loop_idx = loop_idx;
+        // 跳转 (cached 为 false) 不算重复
+        if (g->cached)
+            anime_emit(g->owner, XANIME_EVENT_REPEAT);
+        // 无限循环时回绕时间，避免计数溢出
+        if (g->repeat_cnt == LV_ANIM_REPEAT_INFINITE)
+        {
+            g->elapsed -= loop_idx * g->dur;
+            g->loop_idx = 0;
+        }
+    }
+
+    // 全部对象不可见时只推进时间，重新可见后直接定位到当前时间；需要强制写入时 (跳转) 不剔除
+    if (g->cached && group_cull(g))
+        return false;
+    g->culling = g->cached && g->culled;
+    group_seek(g, t % g->dur);
+    g->culling = false;
+    return false;
+}
+
+/********************************************************************************
+ * @brief: 按检测间隔更新组内对象的可见性
+ * @param {group_anim_t*} g
+ * @return {*} 所有对象都不可见时返回 true
+ ********************************************************************************/
+static bool group_cull(group_anim_t *g)
+{
+    if (!g->culled)
+        return false;
+    if (cull_due(g->cull_tick))
+    {
+        g->cull_tick = lv_tick_get();
+        g->cull_num = 0;
+        for (uint16_t i = 0; i < g->obj_num; i++)
+        {
+            g->culled[i] = g->objs[i] && obj_culled(g->objs[i]);
+            g->cull_num += g->culled[i];
+        }
+    }
+    return g->obj_live > 0 && g->cull_num == g->obj_live;
+}
+
+/********************************************************************************
+ * @brief: 组动画处于开始前的延迟中时，不需要更新
+ * @param {driver_node_t*} node
+ * @return {*} 延迟剩余的真实时间 (ms)
+ ********************************************************************************/
+static uint32_t group_idle(const driver_node_t *node)
+{
+    const group_anim_t *g = (const group_anim_t *)node;
+    if (g->reversed || g->elapsed >= g->delay)
+        return 0;
+    return (uint32_t)(((uint64_t)(g->delay - g->elapsed) << XANIME_TIMESCALE_SHIFT) / g->timescale);
+}
+
+/********************************************************************************
+ * @brief: 将组内所有通道定位到指定时间
+ * @param {group_anim_t*} g
+ * @param {uint32_t} t 相对一轮开始的时间 (ms)
+ * @return {*}
+ ********************************************************************************/
+static void group_seek(group_anim_t *g, uint32_t t)
+{
+    for (uint8_t c = 0; c < g->ch_num; c++)
+    {
+        group_channel_apply(g, &g->ch[c], t);
+    }
+    g->cached = true;
+}
+
+/********************************************************************************
+ * @brief: 计算通道在指定时间的值并应用到所有对象
+ * @param {group_anim_t*} g
+ * @param {group_channel_t*} ch
+ * @param {uint32_t} t
+ * @return {*}
+ ********************************************************************************/
+static void group_channel_apply(group_anim_t *g, group_channel_t *ch, uint32_t t)
+{
+    const uint32_t *times = ch->times;
+    uint16_t last_seg = ch->kf_num - 2;
+
+    // 顺序播放时段索引逐段前进或后退，跳转时才二分查找
+    if (t < times[ch->seg])
+    {
+        if (ch->seg > 0 && t >= times[ch->seg - 1])
+            ch->seg--;
+        else
+            ch->seg = find_segment(times, ch->kf_num, t);
+    }
+    else
+        while (ch->seg < last_seg && t >= times[ch->seg + 1])
+            ch->seg++;
+
+    uint16_t seg = ch->seg;
+    int32_t progress = segment_progress(ch, seg, t);
+
+    // 同一段内所有对象共用一个缓动进度
+    uint16_t obj_num = g->obj_num;
+    lv_anim_exec_xcb_t exec_cb = ch->exec_cb;
+    const int32_t *from = ch->values + (size_t)seg * obj_num;
+    const int32_t *to = from + obj_num;
+    int32_t *out = g->scratch;
+    if (ch->path_axis != PATH_AXIS_NONE)
+    {
+        // 路径按弧长查表，相对路径以开始时的位置 (反向播放为终点) 为原点
+        for (uint16_t i = 0; i < obj_num; i++)
+            out[i] = path_value(g->path, ch->path_axis, progress, g->is_from ? to[i] : from[i]);
+    }
+    else if (ch->color)
+        lerp_color_batch(from, to, out, obj_num, progress);
+    else if (ch->wide)
+        lerp_batch_wide(from, to, out, obj_num, progress);
+    else
+        lerp_batch(from, to, out, obj_num, progress);
+    // 缩放的尺寸通道进入新的一段时提交该段终点 (反向播放为起点) 的真实尺寸，段内只修改缩放
+    uint16_t key = g->reversed ? seg : seg + 1;
+    bool commit = ch->flip && (ch->flip_key != key || !g->cached);
+    if (commit)
+        ch->flip_key = key;
+
+    // 与上次写入相同 (或变化小于阈值) 的对象不写样式也不触发重绘
+    int32_t *last = ch->last;
+    const claim_t *claims = g->claims ? g->claims + (size_t)(ch - g->ch) * obj_num : NULL;
+    uint8_t threshold = ch->color ? 0 : g->threshold;
+    uint32_t skipped = 0;
+    for (uint16_t i = 0; i < obj_num; i++)
+    {
+        // 不可见对象保留上次写入的值，last 与样式保持一致
+        if (!g->objs[i] || (g->culling && g->culled[i]) || (claims && !claims[i].live))
+            continue;
+        if (commit)
+            flip_commit(g->objs[i], ch->prop, ch->values[(size_t)key * obj_num + i]);
+        else if (g->cached && write_skippable(last[i], out[i], out[i] == from[i] || out[i] == to[i], threshold))
+        {
+            skipped++;
+            continue;
+        }
+        last[i] = out[i];
+        group_exec(g, i, exec_cb, out[i]);
+    }
+    if (skipped && g->owner)
+        ANIME_PRIV(g->owner)->skip_cnt += skipped;
+}
+
+/********************************************************************************
+ * @brief: 错开播放时按每个对象自己的时间更新，无限循环在所有对象开始后按整轮回绕
+ * @param {group_anim_t*} g
+ * @param {uint32_t} t 相对延迟结束的时间 (ms)
+ * @return {*}
+ ********************************************************************************/
+static bool group_update_stagger(group_anim_t *g, uint32_t t)
+{
+    // 最后一个对象进入新的一轮时为重复
+    uint32_t loop_idx = t >= g->stagger ? (t - g->stagger) / g->dur : 0;
+    if (loop_idx != g->loop_idx)
+    {
+        g->loop_idx = loop_idx;
+        if (g->cached)
+            anime_emit(g->owner, XANIME_EVENT_REPEAT);
+    }
+    if (g->repeat_cnt == LV_ANIM_REPEAT_INFINITE && loop_idx > 0)
+    {
+        uint32_t wrap = loop_idx * g->dur;
+        g->elapsed -= wrap;
+        t -= wrap;
+        g->loop_idx = 0;
+    }
+
+    if (g->cached && group_cull(g))
+        return false;
+    g->culling = g->cached && g->culled;
+    for (uint8_t c = 0; c < g->ch_num; c++)
+    {
+        group_channel_apply_stagger(g, &g->ch[c], t);
+    }
+    g->culling = false;
+    g->cached = true;
+    return false;
+}
+
+/********************************************************************************
+ * @brief: 错开播放时计算通道在每个对象自己时间上的值，未开始的对象停在起点，已结束的停在终点
+ * @param {group_anim_t*} g
+ * @param {group_channel_t*} ch
+ * @param {uint32_t} t 相对延迟结束的时间 (ms)
+ * @return {*}
+ ********************************************************************************/
+static void group_channel_apply_stagger(group_anim_t *g, group_channel_t *ch, uint32_t t)
+{
+    uint16_t obj_num = g->obj_num;
+    uint64_t total = g->repeat_cnt == LV_ANIM_REPEAT_INFINITE ? UINT64_MAX : (uint64_t)g->dur * g->repeat_cnt;
+    int32_t *last = ch->last;
+    const claim_t *claims = g->claims ? g->claims + (size_t)(ch - g->ch) * obj_num : NULL;
+    uint32_t skipped = 0;
+    for (uint16_t i = 0; i < obj_num; i++)
+    {
+        if (!g->objs[i] || (g->culling && g->culled[i]) || (claims && !claims[i].live))
+            continue;
+        uint32_t local = t > g->offsets[i] ? t - g->offsets[i] : 0;
+        uint32_t round_t = local >= total ? g->dur : local % g->dur;
+        // 通常只有两个关键帧，逐对象查找段的开销很小
+        uint16_t seg = find_segment(ch->times, ch->kf_num, round_t);
+        int32_t from = ch->values[(size_t)seg * obj_num + i];
+        int32_t to = ch->values[(size_t)(seg + 1) * obj_num + i];
+        int32_t progress = segment_progress(ch, seg, round_t);
+        int32_t value;
+        if (ch->path_axis != PATH_AXIS_NONE)
+            value = path_value(g->path, ch->path_axis, progress, g->is_from ? to : from);
+        else if (ch->color)
+            value = lerp_color(from, to, progress);
+        else
+            value = from + (int32_t)((((int64_t)to - from) * progress) >> XANIME_PROGRESS_SHIFT);
+        if (g->cached && write_skippable(last[i], value, value == from || value == to, ch->color ? 0 : g->threshold))
+        {
+            skipped++;
+            continue;
+        }
+        last[i] = value;
+        group_exec(g, i, ch->exec_cb, value);
+    }
+    if (skipped && g->owner)
+        ANIME_PRIV(g->owner)->skip_cnt += skipped;
+}
+
+/********************************************************************************
+ * @brief: 按刚度、阻尼与质量选择稳定的积分步长，半隐式欧拉在 h^2 * k / m 与 h * c / m 都小于 1 时稳定
+ * @param {xanime_spring_t*} spring
+ * @return {*} 不超过 XANIME_SPRING_STEP 的步长 (ms)，最小为 1
+ ********************************************************************************/
+static uint8_t spring_step(const xanime_spring_t *spring)
+{
+    uint64_t mass = spring->mass ? spring->mass : XANIME_SPRING_MASS_ONE;
+    uint8_t step = XANIME_SPRING_STEP;
+    while (step > 1 && ((uint64_t)step * step * spring->stiffness * XANIME_SPRING_MASS_ONE >= 1000000 * mass ||
+                        (uint64_t)step * spring->damping * XANIME_SPRING_MASS_ONE >= 1000 * mass))
+        step--;
+    return step;
+}
+
+/********************************************************************************
+ * @brief: 弹簧回到起始值并清除速度
+ * @param {group_anim_t*} g
+ * @return {*}
+ ********************************************************************************/
+static void group_spring_reset(group_anim_t *g)
+{
+    uint16_t obj_num = g->obj_num;
+    for (uint8_t c = 0; c < g->ch_num; c++)
+    {
+        const int32_t *from = g->ch[c].values;
+        for (uint16_t i = 0; i < obj_num; i++)
+        {
+            g->spring_pos[(size_t)c * obj_num + i] = (int64_t)from[i] * SPRING_ONE;
+            g->spring_vel[(size_t)c * obj_num + i] = 0;
+        }
+    }
+    g->spring_time = 0;
+    g->spring_base = 0;
+}
+
+/********************************************************************************
+ * @brief: 按固定步长积分弹簧，静止或超过 dur 时停在目标值 (惯性停在当前位置)
+ * @param {group_anim_t*} g
+ * @return {*} 动画结束时返回 true
+ ********************************************************************************/
+static bool group_update_spring(group_anim_t *g)
+{
+    if (g->elapsed < g->delay)
+        return false;
+    uint32_t t = g->elapsed - g->delay;
+    // 卡顿后最多追赶 SPRING_CATCH_UP，跳过的时间不积分
+    if (t > g->spring_time + SPRING_CATCH_UP)
+        g->spring_time = t - SPRING_CATCH_UP;
+    while (g->spring_time + g->spring_step <= t)
+    {
+        group_spring_integrate(g);
+        g->spring_time += g->spring_step;
+    }
+
+    if (group_spring_settled(g) || g->spring_time - g->spring_base >= g->dur)
+    {
+        uint16_t obj_num = g->obj_num;
+        for (uint8_t c = 0; c < g->ch_num; c++)
+        {
+            for (uint16_t i = 0; i < obj_num; i++)
+            {
+                size_t k = (size_t)c * obj_num + i;
+                if (g->spring.stiffness > 0)
+                    g->spring_pos[k] = (int64_t)g->ch[c].values[obj_num + i] * SPRING_ONE;
+                g->spring_vel[k] = 0;
+            }
+            group_channel_apply_spring(g, c);
+        }
+        g->cached = true;
+        return true;
+    }
+
+    if (g->cached && group_cull(g))
+        return false;
+    g->culling = g->cached && g->culled;
+    for (uint8_t c = 0; c < g->ch_num; c++)
+    {
+        group_channel_apply_spring(g, c);
+    }
+    g->culling = false;
+    g->cached = true;
+    return false;
+}
+
+/********************************************************************************
+ * @brief: 将积分的中间值限制在 [-limit, limit]
+ * @param {int64_t} v
+ * @param {int64_t} limit
+ * @return {*}
+ ********************************************************************************/
+static int64_t spring_clamp(int64_t v, int64_t limit)
+{
+    return v > limit ? limit : (v < -limit ? -limit : v);
+}
+
+/********************************************************************************
+ * @brief: 所有已开始的对象前进一个积分步长，错开的对象在自己的开始时间之前保持静止
+ * @param {group_anim_t*} g
+ * @return {*}
+ ********************************************************************************/
+static void group_spring_integrate(group_anim_t *g)
+{
+    const xanime_spring_t *spring = &g->spring;
+    int64_t mass = spring->mass ? spring->mass : XANIME_SPRING_MASS_ONE;
+    int64_t step = g->spring_step;
+    uint16_t obj_num = g->obj_num;
+    for (uint8_t c = 0; c < g->ch_num; c++)
+    {
+        const int32_t *to = g->ch[c].values + obj_num;
+        int64_t *pos = g->spring_pos + (size_t)c * obj_num;
+        int64_t *vel = g->spring_vel + (size_t)c * obj_num;
+        for (uint16_t i = 0; i < obj_num; i++)
+        {
+            if (!g->objs[i] || (g->offsets && g->offsets[i] > g->spring_time))
+                continue;
+            // 先更新速度再用新速度更新位置；先除以质量再乘步长，大距离与高刚度时不会溢出
+            int64_t disp = spring_clamp(pos[i] - (int64_t)to[i] * SPRING_ONE, SPRING_LIMIT);
+            int64_t v = spring_clamp(vel[i], SPRING_LIMIT);
+            int64_t force = -(int64_t)spring->stiffness * disp - (int64_t)spring->damping * v;
+            int64_t accel = spring_clamp(force / mass, SPRING_LIMIT);
+            vel[i] = spring_clamp(v + accel * XANIME_SPRING_MASS_ONE * step / 1000, SPRING_LIMIT);
+            pos[i] = spring_clamp(pos[i] + vel[i] * step / 1000, (int64_t)INT32_MAX << SPRING_SHIFT);
+        }
+    }
+}
+
+/********************************************************************************
+ * @brief: 判断弹簧是否静止：所有对象都已开始，速度低于静止速度且与目标相差不到半个单位
+ * @param {group_anim_t*} g
+ * @return {*}
+ ********************************************************************************/
+static bool group_spring_settled(const group_anim_t *g)
+{
+    if (g->offsets && g->spring_time < g->stagger)
+        return false;
+    int64_t rest = (int64_t)(g->spring.rest_speed ? g->spring.rest_speed : XANIME_SPRING_REST_SPEED) << SPRING_SHIFT;
+    int64_t half = (int64_t)1 << (SPRING_SHIFT - 1);
+    uint16_t obj_num = g->obj_num;
+    for (uint8_t c = 0; c < g->ch_num; c++)
+    {
+        const int32_t *to = g->ch[c].values + obj_num;
+        for (uint16_t i = 0; i < obj_num; i++)
+        {
+            if (!g->objs[i])
+                continue;
+            size_t k = (size_t)c * obj_num + i;
+            int64_t vel = g->spring_vel[k];
+            if (vel >= rest || vel <= -rest)
+                return false;
+            // 惯性没有目标值
+            int64_t diff = g->spring_pos[k] - (int64_t)to[i] * SPRING_ONE;
+            if (g->spring.stiffness > 0 && (diff >= half || diff <= -half))
+                return false;
+        }
+    }
+    return true;
+}
+
+/********************************************************************************
+ * @brief: 将弹簧通道的当前位置四舍五入后写入对象
+ * @param {group_anim_t*} g
+ * @param {uint8_t} c 通道索引
+ * @return {*}
+ ********************************************************************************/
+static void group_channel_apply_spring(group_anim_t *g, uint8_t c)
+{
+    group_channel_t *ch = &g->ch[c];
+    uint16_t obj_num = g->obj_num;
+    const int64_t *pos = g->spring_pos + (size_t)c * obj_num;
+    const int32_t *to = ch->values + obj_num;
+    int32_t *last = ch->last;
+    const claim_t *claims = g->claims ? g->claims + (size_t)c * obj_num : NULL;
+    uint32_t skipped = 0;
+    for (uint16_t i = 0; i < obj_num; i++)
+    {
+        if (!g->objs[i] || (g->culling && g->culled[i]) || (claims && !claims[i].live))
+            continue;
+        int64_t rounded = (pos[i] + ((int64_t)1 << (SPRING_SHIFT - 1))) >> SPRING_SHIFT;
+        int32_t value = (int32_t)LV_CLAMP(INT32_MIN, rounded, INT32_MAX);
+        if (g->cached && write_skippable(last[i], value, value == to[i], g->threshold))
+        {
+            skipped++;
+            continue;
+        }
+        last[i] = value;
+        group_exec(g, i, ch->exec_cb, value);
+    }
+    if (skipped && g->owner)
+        ANIME_PRIV(g->owner)->skip_cnt += skipped;
+}
+
+/********************************************************************************
+ * @brief: 将值写入组内对象，使用快照时写入快照
+ * @param {group_anim_t*} g
+ * @param {uint16_t} i
+ * @param {lv_anim_exec_xcb_t} exec_cb
+ * @param {int32_t} value
+ * @return {*}
+ ********************************************************************************/
+static void group_exec(group_anim_t *g, uint16_t i, lv_anim_exec_xcb_t exec_cb, int32_t value)
+{
+    if (!g->snaps || !g->snaps[i].proxy)
+        exec_cb(g->objs[i], value);
+#if LV_USE_CANVAS
+    else if (g->snaps[i].sprite && exec_cb == rotate_exec_cb)
+        sprite_exec_cb(g->snaps[i].proxy, value);
+#endif
+    else
+        exec_cb(g->snaps[i].proxy, value);
+}
+
+/********************************************************************************
+ * @brief: 计算段内缓动后的进度
+ * @param {group_channel_t*} ch
+ * @param {uint16_t} seg
+ * @param {uint32_t} t 相对一轮开始的时间 (ms)
+ * @return {*}
+ ********************************************************************************/
+static int32_t segment_progress(const group_channel_t *ch, uint16_t seg, uint32_t t)
+{
+    uint32_t seg_start = ch->times[seg];
+    uint32_t seg_dur = ch->times[seg + 1] - seg_start;
+    if (t >= ch->times[seg + 1])
+        return XANIME_PROGRESS_MAX;
+    if (t <= seg_start || seg_dur == 0)
+        return 0;
+    return ease_progress(ch->easings[seg + 1], t - seg_start, seg_dur);
+}
+
+/********************************************************************************
+ * @brief: 二分查找时间所在的段
+ * @param {uint32_t*} times 非递减的关键帧时间
+ * @param {uint16_t} kf_num 关键帧数量，至少为 2
+ * @param {uint32_t} t
+ * @return {*} 满足 times[seg] <= t 的最大段索引
+ ********************************************************************************/
+static uint16_t find_segment(const uint32_t *times, uint16_t kf_num, uint32_t t)
+{
+    uint16_t lo = 0;
+    uint16_t hi = kf_num - 2;
+    while (lo < hi)
+    {
+        uint16_t mid = (uint16_t)((lo + hi + 1) / 2);
+        if (times[mid] <= t)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return lo;
+}
+
+/********************************************************************************
+ * @brief: 计算缓动后的进度
+ * @param {uint8_t} easing
+ * @param {uint32_t} t 段内时间
+ * @param {uint32_t} dur 段时长
+ * @return {*} [0, XANIME_PROGRESS_MAX]，回弹类缓动可能超出范围
+ ********************************************************************************/
+static int32_t ease_progress(uint8_t easing, uint32_t t, uint32_t dur)
+{
+    return ease_eval(easing, (int32_t)(((uint64_t)t << XANIME_PROGRESS_SHIFT) / dur));
+}
+
+/********************************************************************************
+ * @brief: 组动画总时长，包含延迟与所有循环
+ * @param {group_anim_t*} g
+ * @return {*} 无限循环返回 XANIME_TIME_INFINITE
+ ********************************************************************************/
+static uint32_t group_span(const group_anim_t *g)
+{
+    if (g->repeat_cnt == LV_ANIM_REPEAT_INFINITE)
+        return XANIME_TIME_INFINITE;
+    uint64_t span = (uint64_t)g->delay + g->stagger + (uint64_t)g->dur * g->repeat_cnt;
+    return span >= XANIME_TIME_INFINITE ? XANIME_TIME_INFINITE - 1 : (uint32_t)span;
+}
+
+/********************************************************************************
+ * @brief: 64 位整数平方根
+ * @param {uint64_t} v
+ * @return {*} floor(sqrt(v))
+ ********************************************************************************/
+static uint32_t isqrt64(uint64_t v)
+{
+    uint64_t res = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > v)
+        bit >>= 2;
+    while (bit)
+    {
+        if (v >= res + bit)
+        {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        }
+        else
+            res >>= 1;
+        bit >>= 2;
+    }
+    return (uint32_t)res;
+}
+
+/********************************************************************************
+ * @brief: 对象到错开起点的距离，一行时为索引差，网格中为欧氏距离
+ * @param {xanime_spec_t*} spec
+ * @param {uint32_t} idx 对象索引
+ * @param {uint32_t} num 对象数量
+ * @return {*} 距离 (1/32 个对象间距)
+ ********************************************************************************/
+static uint32_t stagger_dist(const xanime_spec_t *spec, uint32_t idx, uint32_t num)
+{
+    uint32_t cols = spec->stagger_grid > 0 && spec->stagger_grid < num ? spec->stagger_grid : num;
+    uint32_t rows = (num + cols - 1) / cols;
+    // 坐标放大 2 倍，中心落在整数上
+    int64_t ox = 0;
+    int64_t oy = 0;
+    if (spec->stagger_from == XANIME_STAGGER_CENTER)
+    {
+        ox = cols - 1;
+        oy = rows - 1;
+    }
+    else if (spec->stagger_from == XANIME_STAGGER_LAST)
+    {
+        ox = 2 * ((num - 1) % cols);
+        oy = 2 * ((num - 1) / cols);
+    }
+    int64_t dx = 2 * (int64_t)(idx % cols) - ox;
+    int64_t dy = 2 * (int64_t)(idx / cols) - oy;
+    // 放大 2 倍的距离再放大 16 倍
+    return isqrt64((uint64_t)(dx * dx + dy * dy) << 8);
+}
+
+/********************************************************************************
+ * @brief: 计算对象的错开时间，设置缓动时按距离占最大距离的比例缓动
+ * @param {xanime_spec_t*} spec
+ * @param {uint16_t} idx
+ * @param {uint16_t} num
+ * @return {*} 相对 delay 的开始时间 (ms)
+ ********************************************************************************/
+static uint32_t stagger_offset(const xanime_spec_t *spec, uint16_t idx, uint16_t num)
+{
+    if (spec->stagger == 0 || num < 2)
+        return 0;
+    uint32_t dist = stagger_dist(spec, idx, num);
+    if (spec->stagger_easing != XANIME_EASE_LINEAR)
+    {
+        // 最远的对象在网格凸包的顶点上: 首行两端、末行两端与倒数第二行末尾
+        uint32_t cols = spec->stagger_grid > 0 && spec->stagger_grid < num ? spec->stagger_grid : num;
+        uint32_t last_row = (num - 1) / cols * cols;
+        uint32_t corners[5] = {0, cols - 1, last_row, num - 1U, last_row > 0 ? last_row - 1 : 0};
+        uint32_t max = 0;
+        for (uint8_t k = 0; k < 5; k++)
+        {
+            uint32_t d = stagger_dist(spec, corners[k], num);
+            if (d > max)
+                max = d;
+        }
+        if (max > 0)
+        {
+            int32_t p = ease_eval(ease_normalize(spec->stagger_easing),
+                                  (int32_t)(((uint64_t)dist << XANIME_PROGRESS_SHIFT) / max));
+            // 回弹类缓动可能超出范围，错开时间不小于 0
+            dist = p > 0 ? (uint32_t)(((uint64_t)p * max) >> XANIME_PROGRESS_SHIFT) : 0;
+        }
+    }
+    return (uint32_t)(((uint64_t)dist * spec->stagger + 16) >> 5);
+}
+
+/********************************************************************************
+ * @brief: 构建运动路径的弧长查找表，贝塞尔曲线展开为折线，弧长按顶点累计
+ * @param {xanime_spec_t*} spec spec->path 已通过检查
+ * @return {*} 分配失败时返回 NULL
+ ********************************************************************************/
+static path_lut_t *path_lut_build(const xanime_spec_t *spec)
+{
+    const xanime_path_t *path = spec->path;
+    bool bezier = path->type == XANIME_PATH_BEZIER;
+    uint16_t steps = bezier ? XANIME_PATH_BEZIER_STEPS : 1;
+    uint16_t seg_num = bezier ? (path->point_num - 1) / 3 : path->point_num - 1;
+    uint16_t piece_num = seg_num * steps;
+
+    // 查找表与顶点、弧长、角度一次分配
+    size_t size = sizeof(path_lut_t) + (size_t)(piece_num + 1) * (2 * sizeof(int32_t) + sizeof(uint32_t)) +
+                  (size_t)piece_num * 2 * sizeof(int16_t);
+    path_lut_t *lut = pool_alloc(XANIME_POOL_DATA, size);
+    if (!lut)
+    {
+        printf("Error: Failed to allocate motion path\n");
+        return NULL;
+    }
+    lut->refs = 1;
+    lut->piece_num = piece_num;
+    lut->xs = (int32_t *)(lut + 1);
+    lut->ys = lut->xs + piece_num + 1;
+    lut->dist = (uint32_t *)(lut->ys + piece_num + 1);
+    lut->angles = (int16_t *)(lut->dist + piece_num + 1);
+    lut->relative = path->relative;
+    lut->reverse = spec->is_from;
+    lut->rotate_offset = path->rotate_offset;
+    lut->cache_progress = INT32_MIN;
+
+    // 展开顶点，坐标保留 4 位小数
+    const int64_t n3 = (int64_t)steps * steps * steps;
+    uint16_t k = 0;
+    for (uint16_t seg = 0; seg < seg_num; seg++)
+    {
+        const lv_point_t *p = bezier ? &path->points[seg * 3] : &path->points[seg];
+        for (uint16_t i = 0; i < steps; i++, k++)
+        {
+            if (!bezier)
+            {
+                lut->xs[k] = p[0].x * 16;
+                lut->ys[k] = p[0].y * 16;
+                continue;
+            }
+            // B(t) = (1-t)^3 P0 + 3(1-t)^2 t P1 + 3(1-t) t^2 P2 + t^3 P3，t = i / steps
+            int64_t u = steps - i;
+            int64_t w0 = u * u * u, w1 = 3 * u * u * i, w2 = 3 * u * i * i, w3 = (int64_t)i * i * i;
+            lut->xs[k] = (int32_t)(((w0 * p[0].x + w1 * p[1].x + w2 * p[2].x + w3 * p[3].x) * 16 + n3 / 2) / n3);
+            lut->ys[k] = (int32_t)(((w0 * p[0].y + w1 * p[1].y + w2 * p[2].y + w3 * p[3].y) * 16 + n3 / 2) / n3);
+        }
+    }
+    lut->xs[piece_num] = path->points[path->point_num - 1].x * 16;
+    lut->ys[piece_num] = path->points[path->point_num - 1].y * 16;
+
+    // 累计弧长与切线角度
+    lut->dist[0] = 0;
+    for (k = 0; k < piece_num; k++)
+    {
+        int64_t dx = lut->xs[k + 1] - lut->xs[k];
+        int64_t dy = lut->ys[k + 1] - lut->ys[k];
+        lut->dist[k + 1] = lut->dist[k] + isqrt64((uint64_t)(dx * dx + dy * dy));
+        int16_t chord = (int16_t)path_atan2(dy, dx);
+        lut->angles[k * 2] = chord;
+        lut->angles[k * 2 + 1] = chord;
+        if (!bezier)
+            continue;
+        // 贝塞尔曲线取段两端的解析切线，控制点与端点重合导致切线为 0 时使用弦的方向
+        const lv_point_t *p = &path->points[k / steps * 3];
+        for (uint16_t end = 0; end < 2; end++)
+        {
+            int64_t i = k % steps + end;
+            int64_t u = steps - i;
+            int64_t w0 = u * u, w1 = 2 * u * i, w2 = i * i;
+            int64_t tx = w0 * (p[1].x - p[0].x) + w1 * (p[2].x - p[1].x) + w2 * (p[3].x - p[2].x);
+            int64_t ty = w0 * (p[1].y - p[0].y) + w1 * (p[2].y - p[1].y) + w2 * (p[3].y - p[2].y);
+            if (tx != 0 || ty != 0)
+                lut->angles[k * 2 + end] = (int16_t)path_atan2(ty, tx);
+        }
+    }
+    lut->length = lut->dist[piece_num];
+
+    // 弧长均分，记录每份起点所在的段
+    uint16_t piece = 0;
+    for (uint16_t b = 0; b <= XANIME_PATH_LUT_SIZE; b++)
+    {
+        uint32_t target = (uint32_t)((uint64_t)lut->length * b / XANIME_PATH_LUT_SIZE);
+        while (piece + 1 < piece_num && lut->dist[piece + 1] <= target)
+            piece++;
+        lut->bucket[b] = piece;
+    }
+    return lut;
+}
+
+/********************************************************************************
+ * @brief: 增加查找表的引用
+ * @param {path_lut_t*} lut
+ * @return {*}
+ ********************************************************************************/
+static path_lut_t *path_lut_ref(path_lut_t *lut)
+{
+    lut->refs++;
+    return lut;
+}
+
+/********************************************************************************
+ * @brief: 释放查找表的引用，最后一个引用释放时释放查找表
+ * @param {path_lut_t*} lut 可以为 NULL
+ * @return {*}
+ ********************************************************************************/
+static void path_lut_put(path_lut_t *lut)
+{
+    if (lut && --lut->refs == 0)
+        pool_free(XANIME_POOL_DATA, lut);
+}
+
+/********************************************************************************
+ * @brief: 计算路径在指定进度的位置与切线角度，从均分弧长的对应份开始查找，每帧为常数时间
+ * @param {path_lut_t*} lut
+ * @param {int32_t} progress 缓动后的进度，超出 [0, XANIME_PROGRESS_MAX] 时停在端点
+ * @return {*}
+ ********************************************************************************/
+static void path_eval(path_lut_t *lut, int32_t progress)
+{
+    lut->cache_progress = progress;
+    int32_t q = LV_CLAMP(0, progress, XANIME_PROGRESS_MAX);
+    if (lut->reverse)
+        q = XANIME_PROGRESS_MAX - q;
+
+    uint32_t s = (uint32_t)(((uint64_t)lut->length * q) >> XANIME_PROGRESS_SHIFT);
+    uint32_t b = lut->length ? (uint32_t)((uint64_t)s * XANIME_PATH_LUT_SIZE / lut->length) : 0;
+    uint16_t p = lut->bucket[b];
+    while (p + 1 < lut->piece_num && lut->dist[p + 1] < s)
+        p++;
+
+    // 段内按弧长线性插值
+    int64_t f = s - lut->dist[p];
+    int64_t len = lut->dist[p + 1] - lut->dist[p];
+    int64_t x = lut->xs[p];
+    int64_t y = lut->ys[p];
+    int32_t a0 = lut->angles[p * 2];
+    int32_t da = lut->angles[p * 2 + 1] - a0;
+    // 切线角度按较小的一侧转动
+    if (da > 1800)
+        da -= 3600;
+    else if (da < -1800)
+        da += 3600;
+    if (len > 0)
+    {
+        x += (lut->xs[p + 1] - x) * f / len;
+        y += (lut->ys[p + 1] - y) * f / len;
+        a0 += (int32_t)(da * f / len);
+    }
+    // 反向播放时朝向相反
+    if (lut->reverse)
+        a0 += 1800;
+    lut->cache_value[PATH_AXIS_X] = (int32_t)((x + 8) >> 4);
+    lut->cache_value[PATH_AXIS_Y] = (int32_t)((y + 8) >> 4);
+    lut->cache_value[PATH_AXIS_ANGLE] = (a0 % 3600 + 3600) % 3600;
+}
+
+/********************************************************************************
+ * @brief: 路径驱动的通道在指定进度的值
+ * @param {path_lut_t*} lut
+ * @param {uint8_t} axis path_axis_t
+ * @param {int32_t} progress 缓动后的进度
+ * @param {int32_t} origin 对象开始时的坐标，只用于相对路径
+ * @return {*}
+ ********************************************************************************/
+static int32_t path_value(path_lut_t *lut, uint8_t axis, int32_t progress, int32_t origin)
+{
+    if (progress != lut->cache_progress)
+        path_eval(lut, progress);
+    int32_t v = lut->cache_value[axis];
+    if (axis == PATH_AXIS_ANGLE)
+        return v + lut->rotate_offset;
+    return lut->relative ? origin + v : v;
+}
+
+/********************************************************************************
+ * @brief: 属性由运动路径驱动的分量，设置了关键帧轨道的属性按轨道播放
+ * @param {xanime_spec_t*} spec
+ * @param {uint8_t} prop
+ * @return {*} 不由路径驱动时返回 PATH_AXIS_NONE
+ ********************************************************************************/
+static uint8_t path_axis(const xanime_spec_t *spec, uint8_t prop)
+{
+    if (!spec->path || prop >= ANIM_PROP_COUNT || spec->tracks[prop].num > 0)
+        return PATH_AXIS_NONE;
+    if (prop == XANIME_PROP_X)
+        return PATH_AXIS_X;
+    if (prop == XANIME_PROP_Y)
+        return PATH_AXIS_Y;
+    if (prop == XANIME_PROP_ROTATE && spec->path->auto_rotate)
+        return PATH_AXIS_ANGLE;
+    return PATH_AXIS_NONE;
+}
+
+/********************************************************************************
+ * @brief: 整数 atan2，y 轴向下时为顺时针角度，与 LVGL 的旋转方向一致
+ * @param {int64_t} dy
+ * @param {int64_t} dx
+ * @return {*} [0, 3600) (0.1 度)，误差约 0.3 度
+ ********************************************************************************/
+static int32_t path_atan2(int64_t dy, int64_t dx)
+{
+    if (dx == 0 && dy == 0)
+        return 0;
+    uint64_t ax = dx < 0 ? (uint64_t)-dx : (uint64_t)dx;
+    uint64_t ay = dy < 0 ? (uint64_t)-dy : (uint64_t)dy;
+    bool steep = ay > ax;
+    // 折算到第一象限的 [0, 45] 度，z 为 Q15 的斜率
+    int64_t z = (int64_t)(((steep ? ax : ay) << 15) / (steep ? ay : ax));
+    // atan(z) ≈ 45z + 15.64z(1 - z) 度
+    int32_t a = (int32_t)((z * (450 * 32768 + 1564 * (32768 - z) / 10)) >> 30);
+    if (steep)
+        a = 900 - a;
+    if (dx < 0)
+        a = 1800 - a;
+    if (dy < 0)
+        a = 3600 - a;
+    return a % 3600;
+}
+
+/********************************************************************************
+ * @brief: 调用组动画的完成回调，a->var 为第一个未删除的对象，对象全部删除时不调用
+ * @param {group_anim_t*} g
+ * @return {*}
+ ********************************************************************************/
+static void group_notify_complete(group_anim_t *g)
+{
+    if (!g->complete_cb)
+        return;
+    uint16_t i = 0;
+    while (i < g->obj_num && !g->objs[i])
+        i++;
+    if (i == g->obj_num)
+        return;
+    lv_anim_t a;
+    lv_anim_init(&a);
+    a.var = g->objs[i];
+    a.user_data = g->user_data;
+    g->complete_cb(&a);
+}
+
+/********************************************************************************
+ * @brief: 推进组动画的时钟
+ * @param {driver_node_t*} node
+ * @param {uint32_t} now 当前 tick
+ * @return {*} 动画结束时返回 true
+ ********************************************************************************/
+static bool group_advance(driver_node_t *node, uint32_t now)
+{
+    group_anim_t *g = (group_anim_t *)node;
+    uint32_t delta = now - node->last_tick;
+    node->last_tick = now;
+    // 所有属性都被其他动画覆盖
+    if (g->killed)
+        return true;
+
+    if (g->timescale != XANIME_TIMESCALE_NORMAL)
+    {
+        // 定点缩放，余数累积到下一帧，低倍速时不丢失时间
+        uint64_t scaled = (uint64_t)delta * g->timescale + g->time_frac;
+        delta = (uint32_t)(scaled >> XANIME_TIMESCALE_SHIFT);
+        g->time_frac = (uint16_t)(scaled & ((1 << XANIME_TIMESCALE_SHIFT) - 1));
+    }
+    if (g->reversed)
+        g->elapsed = g->elapsed > delta ? g->elapsed - delta : 0;
+    else
+        g->elapsed += delta;
+    bool done = group_update(g);
+    // 延迟期间没有写入
+    if (g->elapsed >= g->delay)
+        anime_emit(g->owner, XANIME_EVENT_UPDATE);
+    return done;
+}
+
+/********************************************************************************
+ * @brief: 组动画结束，调用完成回调；不属于控制器的组动画随后释放
+ * @param {driver_node_t*} node
+ * @return {*}
+ ********************************************************************************/
+static void group_finish(driver_node_t *node)
+{
+    group_anim_t *g = (group_anim_t *)node;
+    xanime_t *owner = g->owner;
+    g->active = false;
+    if (owner)
+        owner->is_playing = false;
+    group_snapshot(g, false);
+    group_unclaim(g);
+
+    // 回调中可能删除或重新播放控制器，之后不再访问 g；被覆盖的动画不调用完成回调
+    if (!g->killed)
+    {
+        anime_emit(owner, XANIME_EVENT_COMPLETE);
+        group_notify_complete(g);
+    }
+    if (!owner)
+        group_free(g);
+}
+
+/********************************************************************************
+ * @brief: 将组动画每个对象的每个属性登记到覆盖索引，已被覆盖的属性恢复
+ * @param {group_anim_t*} g
+ * @return {*}
+ ********************************************************************************/
+static void group_claim(group_anim_t *g)
+{
+    uint32_t num = (uint32_t)g->ch_num * g->obj_num;
+    if (!g->claims)
+    {
+        g->claims = XANIME_MALLOC(num * sizeof(claim_t));
+        if (!g->claims)
+            return;
+        memset(g->claims, 0, num * sizeof(claim_t));
+    }
+    for (uint8_t c = 0; c < g->ch_num; c++)
+    {
+        for (uint16_t i = 0; i < g->obj_num; i++)
+        {
+            claim_t *claim = &g->claims[(size_t)c * g->obj_num + i];
+            if (claim->live || !g->objs[i])
+                continue;
+            claim->obj = g->objs[i];
+            claim->runner = g;
+            claim->prop = g->ch[c].prop;
+            claim->is_group = true;
+            claim->live = true;
+            claim_insert(claim);
+            g->claim_live++;
+        }
+    }
+    g->killed = false;
+}
+
+/********************************************************************************
+ * @brief: 将组动画的所有记录移出覆盖索引，结束的动画不再被覆盖
+ * @param {group_anim_t*} g
+ * @return {*}
+ ********************************************************************************/
+static void group_unclaim(group_anim_t *g)
+{
+    if (!g->claims)
+        return;
+    uint32_t num = (uint32_t)g->ch_num * g->obj_num;
+    for (uint32_t k = 0; k < num; k++)
+    {
+        if (!g->claims[k].live)
+            continue;
+        claim_remove(&g->claims[k]);
+        g->claims[k].live = false;
+    }
+    g->claim_live = 0;
+}
+
+/********************************************************************************
+ * @brief: 释放组动画，移除对象上的删除事件
+ * @param {group_anim_t*} g
+ * @return {*}
+ ********************************************************************************/
+static void group_free(group_anim_t *g)
+{
+    group_snapshot(g, false);
+    group_unclaim(g);
+    XANIME_FREE(g->claims);
+    path_lut_put(g->path);
+    for (uint16_t i = 0; i < g->obj_num; i++)
+    {
+        if (g->objs[i])
+            lv_obj_remove_event_cb_with_user_data(g->objs[i], group_obj_delete_cb, g);
+    }
+    pool_free(XANIME_POOL_DATA, g);
+}
+
+/********************************************************************************
+ * @brief: 组内对象被删除时停止更新该对象
+ * @param {lv_event_t*} e
+ * @return {*}
+ ********************************************************************************/
+static void group_obj_delete_cb(lv_event_t *e)
+{
+    group_anim_t *g = lv_event_get_user_data(e);
+    lv_obj_t *obj = lv_event_get_target(e);
+    for (uint16_t i = 0; i < g->obj_num; i++)
+    {
+        if (g->objs[i] == obj)
+        {
+            g->objs[i] = NULL;
+            g->obj_live--;
+            // 对象地址可能被新对象复用，从覆盖索引中移除
+            for (uint8_t c = 0; g->claims && c < g->ch_num; c++)
+            {
+                claim_t *claim = &g->claims[(size_t)c * g->obj_num + i];
+                if (!claim->live)
+                    continue;
+                claim_remove(claim);
+                claim->live = false;
+                g->claim_live--;
+            }
+        }
+    }
+    if (g->claims && g->claim_live == 0)
+        g->killed = true;
+    // 对象全部删除后停止驱动，无限循环不会继续占用定时器
+    if (g->obj_live > 0 || !g->active)
+        return;
+    group_stop(g);
+    if (g->owner)
+        g->owner->is_playing = false;
+    else
+        group_free(g);
+}
+
+/********************************************************************************
+ * @brief: 将节点注册到驱动，按需创建或恢复定时器
+ * @param {driver_node_t*} node
+ * @return {*}
+ ********************************************************************************/
+static void driver_add(driver_node_t *node)
+{
+    node->last_tick = lv_tick_get();
+    node->phase = driver.phase_seq++;
+    node->next = driver.head;
+    driver.head = node;
+    sched_attach();
+
+    if (!driver.timer)
+    {
+        driver.timer = lv_timer_create(driver_timer_cb, LV_DEF_REFR_PERIOD, NULL);
+        driver.period = LV_DEF_REFR_PERIOD;
+        driver.run_tick = node->last_tick;
+    }
+    else
+    {
+        lv_timer_resume(driver.timer);
+        driver_wake();
+    }
+}
+
+/********************************************************************************
+ * @brief: 从驱动中移除节点
+ * @param {driver_node_t*} node
+ * @return {*}
+ ********************************************************************************/
+static void driver_remove(driver_node_t *node)
+{
+    if (driver.next == node)
+        driver.next = node->next;
+    for (driver_node_t **link = &driver.head; *link; link = &(*link)->next)
+    {
+        if (*link == node)
+        {
+            *link = node->next;
+            node->next = NULL;
+            return;
+        }
+    }
+    for (driver_node_t **link = &driver.finished; *link; link = &(*link)->next)
+    {
+        if (*link == node)
+        {
+            *link = node->next;
+            node->next = NULL;
+            return;
+        }
+    }
+}
+
+/********************************************************************************
+ * @brief: 驱动定时器回调，推进所有组动画与时间轴
+ * @param {lv_timer_t*} timer
+ * @return {*}
+ ********************************************************************************/
+static void driver_timer_cb(lv_timer_t *timer)
+{
+    uint32_t now = lv_tick_get();
+    driver.frame++;
+    // 推进中的回调可能删除任意节点，下一个节点保存在 driver.next，由 driver_remove 维护
+    for (driver_node_t *node = driver.head; node; node = driver.next)
+    {
+        driver.next = node->next;
+        // 降频或限制帧率的节点本帧不推进，下次推进时补上经过的时间
+        uint32_t div = sched_divider(node->priority);
+        if ((div > 1 && (driver.frame + node->phase) % div != 0) ||
+            (node->interval && now - node->last_tick < node->interval))
+            continue;
+        if (!node->advance(node, now))
+            continue;
+
+        // 按原顺序移到结束链表，遍历完成后再调用完成回调
+        driver_remove(node);
+        driver_node_t **tail = &driver.finished;
+        while (*tail)
+            tail = &(*tail)->next;
+        *tail = node;
+    }
+    driver.next = NULL;
+
+    // 回调中可以创建新动画，也可以删除其他控制器与时间轴，尚未调用的节点会从结束链表中移除
+    while (driver.finished)
+    {
+        driver_node_t *node = driver.finished;
+        driver.finished = node->next;
+        node->next = NULL;
+        node->finish(node);
+    }
+
+    driver.update_ms += lv_tick_elaps(now);
+    if (!driver.head)
+        lv_timer_pause(timer);
+    else
+        driver_reschedule(now);
+}
+
+/********************************************************************************
+ * @brief: 按所有节点下一次需要更新的时间设置驱动周期，限制帧率或处于延迟中的动画不再每个周期唤醒
+ * @param {uint32_t} now
+ * @return {*}
+ ********************************************************************************/
+static void driver_reschedule(uint32_t now)
+{
+    uint32_t wait = XANIME_TIME_INFINITE;
+    for (driver_node_t *node = driver.head; node && wait > LV_DEF_REFR_PERIOD; node = node->next)
+    {
+        // 节点的时钟停在上次推进时，等待时间扣除之后经过的时间
+        uint32_t passed = now - node->last_tick;
+        uint32_t w = node->interval > passed ? node->interval - passed : 0;
+        if (node->idle)
+        {
+            uint32_t idle = node->idle(node);
+            w = LV_MAX(w, idle > passed ? idle - passed : 0);
+        }
+        wait = LV_MIN(wait, w);
+    }
+    // 降频按周期计数，负载等级不为 0 时保持默认周期
+    uint32_t period = driver.level > 0 ? LV_DEF_REFR_PERIOD : LV_MAX(wait, LV_DEF_REFR_PERIOD);
+    driver.run_tick = now;
+    if (period == driver.period)
+        return;
+    driver.period = period;
+    lv_timer_set_period(driver.timer, period);
+}
+
+/********************************************************************************
+ * @brief: 恢复默认驱动周期，时钟状态被外部修改后下个周期重新计算
+ * @return {*}
+ ********************************************************************************/
+static void driver_wake(void)
+{
+    if (!driver.timer || driver.period == LV_DEF_REFR_PERIOD)
+        return;
+    driver.period = LV_DEF_REFR_PERIOD;
+    lv_timer_set_period(driver.timer, LV_DEF_REFR_PERIOD);
+}
+
+/********************************************************************************
+ * @brief: 将最高帧率换算为驱动周期的整数倍
+ * @param {uint8_t} fps
+ * @return {*} 最小更新间隔 (ms)，不需要限制时为 0
+ ********************************************************************************/
+static uint16_t fps_interval(uint8_t fps)
+{
+    if (fps == 0)
+        return 0;
+    uint32_t ticks = (1000 / fps + LV_DEF_REFR_PERIOD / 2) / LV_DEF_REFR_PERIOD;
+    return ticks > 1 ? (uint16_t)(ticks * LV_DEF_REFR_PERIOD) : 0;
+}
+
+/********************************************************************************
+ * @brief: 在默认显示器上注册刷新事件，用于测量每帧的渲染时间
+ * @return {*}
+ ********************************************************************************/
+static void sched_attach(void)
+{
+    // 预算为 0 时不测量，负载等级保持为 0
+    if (XANIME_FRAME_BUDGET == 0)
+        return;
+    lv_display_t *disp = lv_display_get_default();
+    if (!disp || disp == driver.disp)
+        return;
+    driver.disp = disp;
+    lv_display_add_event_cb(disp, sched_refr_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(disp, sched_refr_cb, LV_EVENT_REFR_READY, NULL);
+}
+
+/********************************************************************************
+ * @brief: 显示器刷新事件，按每帧开销 (驱动更新 + 渲染) 调整负载等级
+ * @param {lv_event_t*} e
+ * @return {*}
+ ********************************************************************************/
+static void sched_refr_cb(lv_event_t *e)
+{
+    uint32_t now = lv_tick_get();
+    if (lv_event_get_code(e) == LV_EVENT_REFR_START)
+    {
+        driver.refr_start = now;
+        return;
+    }
+
+    uint32_t cost = (now - driver.refr_start + driver.update_ms) << 4;
+    driver.update_ms = 0;
+    // 平滑后再比较，单帧的尖峰不会触发降频
+    driver.cost = driver.cost + (cost >> 3) - (driver.cost >> 3);
+    if (driver.hold > 0)
+    {
+        driver.hold--;
+        return;
+    }
+    // 超出预算时升一级，低于预算的 3/4 时降一级，调整后保持若干帧等待平滑值稳定
+    if (driver.cost > (XANIME_FRAME_BUDGET << 4) && driver.level < XANIME_LOAD_MAX)
+        driver.level++;
+    else if (driver.cost < (XANIME_FRAME_BUDGET * 3 << 2) && driver.level > 0)
+        driver.level--;
+    else
+        return;
+    driver.hold = 8;
+}
+
+/********************************************************************************
+ * @brief: 获取当前负载等级下的更新间隔
+ * @param {uint8_t} priority
+ * @return {*} 每几帧更新一次
+ ********************************************************************************/
+static uint32_t sched_divider(uint8_t priority)
+{
+    if (priority == XANIME_PRIORITY_HIGH)
+        return 1;
+    // 普通优先级在低优先级降到 1/4 后才开始降频
+    uint8_t offset = priority == XANIME_PRIORITY_NORMAL ? 2 : 0;
+    return driver.level > offset ? 1u << (driver.level - offset) : 1;
+}
+
+/********************************************************************************
+ * @brief: 创建时间轴
+ * @return {*}
+ ********************************************************************************/
+xanime_timeline_t *xanime_timeline_create(void)
+{
+    xanime_timeline_t *tl = XANIME_MALLOC(sizeof(xanime_timeline_t));
+    if (!tl)
+        return NULL;
+    memset(tl, 0, sizeof(xanime_timeline_t));
+    tl->node.advance = timeline_advance;
+    tl->node.finish = timeline_finish;
+    return tl;
+}
+
+/********************************************************************************
+ * @brief: 向时间轴添加动画控制器，立即完成布局、百分比与关键帧解析
+ * @param {xanime_timeline_t*} tl
+ * @param {xanime_t*} anime 添加后可以删除，时间轴保存自己的副本
+ * @param {char*} position 开始位置，NULL 表示时间轴末尾，见 README
+ * @return {*}
+ ********************************************************************************/
+bool xanime_timeline_add(xanime_timeline_t *tl, xanime_t *anime, const char *position)
+{
+    if (!tl || !anime || !anime->obj.obj_arr || anime->obj.obj_num == 0 || tl->is_playing)
+        return false;
+
+    uint32_t offset;
+    if (!timeline_position(tl, position, &offset))
+    {
+        printf("Error: Invalid timeline position '%s'\n", position);
+        return false;
+    }
+
+    if (tl->child_num == tl->child_cap)
+    {
+        uint16_t cap = tl->child_cap ? tl->child_cap * 2 : 4;
+        timeline_child_t *children = XANIME_REALLOC(tl->children, cap * sizeof(timeline_child_t));
+        if (!children)
+            return false;
+        tl->children = children;
+        tl->child_cap = cap;
+    }
+
+    // 弹簧的时长在静止前无法确定
+    if (anime->spec.is_spring)
+    {
+        printf("Error: Spring animations cannot be added to a timeline\n");
+        return false;
+    }
+
+    // 与 anime_start 相同，路径查找表由控制器持有，组动画另外引用一次
+    if (anime->spec.path && !ANIME_PRIV(anime)->path_lut)
+        ANIME_PRIV(anime)->path_lut = path_lut_build(&anime->spec);
+
+    refresh_layout(anime);
+    group_anim_t *g = group_build(anime, spec_needs_geom(&anime->spec));
+    if (!g)
+        return false;
+
+    timeline_child_t *child = &tl->children[tl->child_num++];
+    memset(child, 0, sizeof(timeline_child_t));
+    child->runner = g;
+    child->offset = offset;
+    child->span = group_span(g);
+
+    tl->prev_start = offset;
+    if (child->span == XANIME_TIME_INFINITE || offset >= XANIME_TIME_INFINITE - child->span)
+        tl->prev_end = XANIME_TIME_INFINITE;
+    else
+        tl->prev_end = offset + child->span;
+    if (tl->prev_end > tl->duration)
+        tl->duration = tl->prev_end;
+    return true;
+}
+
+/********************************************************************************
+ * @brief: 在时间轴上添加标签
+ * @param {xanime_timeline_t*} tl
+ * @param {char*} label 标签名
+ * @param {char*} position 标签位置，NULL 表示时间轴末尾
+ * @return {*}
+ ********************************************************************************/
+bool xanime_timeline_add_label(xanime_timeline_t *tl, const char *label, const char *position)
+{
+    if (!tl || !check_param(label) || strlen(label) >= XANIME_TIMELINE_LABEL_LEN)
+        return false;
+
+    uint32_t time;
+    if (!timeline_position(tl, position, &time))
+    {
+        printf("Error: Invalid timeline position '%s'\n", position);
+        return false;
+    }
+
+    if (tl->label_num == tl->label_cap)
+    {
+        uint16_t cap = tl->label_cap ? tl->label_cap * 2 : 4;
+        timeline_label_t *labels = XANIME_REALLOC(tl->labels, cap * sizeof(timeline_label_t));
+        if (!labels)
+            return false;
+        tl->labels = labels;
+        tl->label_cap = cap;
+    }
+
+    timeline_label_t *l = &tl->labels[tl->label_num++];
+    strcpy(l->name, label);
+    l->time = time;
+    return true;
+}
+
+/********************************************************************************
+ * @brief: 设置时间轴完成回调
+ * @param {xanime_timeline_t*} tl
+ * @param {lv_anim_ready_cb_t} complete_cb
+ * @param {void*} user_data
+ * @return {*}
+ ********************************************************************************/
+void xanime_timeline_set_complete_cb(xanime_timeline_t *tl, lv_anim_ready_cb_t complete_cb, void *user_data)
+{
+    if (!tl)
+        return;
+    tl->complete_cb = complete_cb;
+    tl->user_data = user_data;
+}
+
+/********************************************************************************
+ * @brief: 获取时间轴总时长
+ * @param {xanime_timeline_t*} tl
+ * @return {*} 包含无限循环的子动画时返回 XANIME_TIME_INFINITE
+ ********************************************************************************/
+uint32_t xanime_timeline_get_duration(xanime_timeline_t *tl)
+{
+    return tl ? tl->duration : 0;
+}
+
+/********************************************************************************
+ * @brief: 启动时间轴，所有子动画由时间轴的一个时钟驱动
+ * @param {xanime_timeline_t*} tl
+ * @return {*}
+ ********************************************************************************/
+xanime_timeline_t *xanime_timeline_start(xanime_timeline_t *tl)
+{
+    if (!tl || tl->is_playing || tl->child_num == 0)
+        return tl;
+
+    tl->elapsed = 0;
+    for (uint16_t i = 0; i < tl->child_num; i++)
+    {
+        tl->children[i].started = false;
+        tl->children[i].finished = false;
+    }
+    tl->is_playing = true;
+    // 时长为 0 的子动画在这里完成，回调中可能删除时间轴
+    if (!timeline_render(tl))
+        return NULL;
+    driver_add(&tl->node);
+    return tl;
+}
+
+/********************************************************************************
+ * @brief: 删除时间轴及其中的子动画
+ * @param {xanime_timeline_t*} tl
+ * @return {*}
+ ********************************************************************************/
+void xanime_timeline_delete(xanime_timeline_t *tl)
+{
+    if (!tl || tl->delete_pending)
+        return;
+    if (tl->is_playing)
+        driver_remove(&tl->node);
+    tl->is_playing = false;
+    // 在子动画的完成回调中删除，由 timeline_render 结束时释放
+    if (tl->in_render)
+    {
+        tl->delete_pending = true;
+        return;
+    }
+    timeline_free(tl);
+}
+
+/********************************************************************************
+ * @brief: 释放时间轴及其中的子动画
+ * @param {xanime_timeline_t*} tl
+ * @return {*}
+ ********************************************************************************/
+static void timeline_free(xanime_timeline_t *tl)
+{
+    for (uint16_t i = 0; i < tl->child_num; i++)
+    {
+        group_free(tl->children[i].runner);
+    }
+    XANIME_FREE(tl->children);
+    XANIME_FREE(tl->labels);
+    XANIME_FREE(tl);
+}
+
+/********************************************************************************
+ * @brief: 解析时间轴位置
+ *         NULL/"" 末尾; "500" 绝对时间; "+=100" "-=100" 相对末尾;
+ *         "<" 上一个开始; ">" 上一个结束; "label"; 以上均可追加 "+=n" "-=n"
+ * @param {xanime_timeline_t*} tl
+ * @param {char*} position
+ * @param {uint32_t*} time
+ * @return {*}
+ ********************************************************************************/
+static bool timeline_position(xanime_timeline_t *tl, const char *position, uint32_t *time)
+{
+    int64_t base = tl->duration;
+    const char *offset = position;
+
+    if (!check_param(position))
+    {
+        offset = NULL;
+    }
+    else if (position[0] == '<' || position[0] == '>')
+    {
+        base = position[0] == '<' ? tl->prev_start : tl->prev_end;
+        offset = position + 1;
+    }
+    else if (isdigit((unsigned char)position[0]))
+    {
+        base = 0;
+    }
+    else if (!(position[0] == '+' || position[0] == '-'))
+    {
+        // 标签
+        size_t len = strcspn(position, "+-");
+        uint16_t i = 0;
+        for (; i < tl->label_num; i++)
+        {
+            if (strlen(tl->labels[i].name) == len && strncmp(tl->labels[i].name, position, len) == 0)
+                break;
+        }
+        if (i == tl->label_num)
+            return false;
+        base = tl->labels[i].time;
+        offset = position + len;
+    }
+
+    if (base >= XANIME_TIME_INFINITE)
+        return false;
+    if (check_param(offset))
+    {
+        xanime_value_t value;
+        if (!parse_value(offset, &value) || value.unit == XANIME_UNIT_PERCENT)
+            return false;
+        // 绝对时间或相对偏移
+        base += value.value;
+    }
+
+    *time = base < 0 ? 0 : (base >= XANIME_TIME_INFINITE ? XANIME_TIME_INFINITE - 1 : (uint32_t)base);
+    return true;
+}
+
+/********************************************************************************
+ * @brief: 按时间轴的当前时间推进所有子动画
+ * @param {xanime_timeline_t*} tl
+ * @return {*} 时间轴在子动画的完成回调中被删除并已释放时返回 false
+ ********************************************************************************/
+static bool timeline_render(xanime_timeline_t *tl)
+{
+    tl->in_render = true;
+    for (uint16_t i = 0; i < tl->child_num && !tl->delete_pending; i++)
+    {
+        timeline_child_t *child = &tl->children[i];
+        if (child->finished || tl->elapsed < child->offset)
+            continue;
+
+        group_anim_t *g = child->runner;
+        if (!child->started)
+        {
+            // 子动画开始时只读取当前值，不做解析和分配
+            child->started = true;
+            group_capture(g);
+        }
+        g->elapsed = tl->elapsed - child->offset;
+        if (group_update(g))
+        {
+            child->finished = true;
+            group_notify_complete(g);
+        }
+    }
+    tl->in_render = false;
+    if (!tl->delete_pending)
+        return true;
+    timeline_free(tl);
+    return false;
+}
+
+/********************************************************************************
+ * @brief: 推进时间轴的主时钟
+ * @param {driver_node_t*} node
+ * @param {uint32_t} now
+ * @return {*} 时间轴结束时返回 true
+ ********************************************************************************/
+static bool timeline_advance(driver_node_t *node, uint32_t now)
+{
+    xanime_timeline_t *tl = (xanime_timeline_t *)node;
+    uint32_t elapsed = tl->elapsed + (now - node->last_tick);
+    node->last_tick = now;
+    // 无限时长的时间轴不会结束，避免计数溢出
+    tl->elapsed = elapsed < tl->elapsed ? XANIME_TIME_INFINITE - 1 : elapsed;
+    // 已被删除时驱动不再访问该节点
+    if (!timeline_render(tl))
+        return false;
+    return tl->duration != XANIME_TIME_INFINITE && tl->elapsed >= tl->duration;
+}
+
+/********************************************************************************
+ * @brief: 时间轴结束，调用完成回调，子动画保留以便再次播放
+ * @param {driver_node_t*} node
+ * @return {*}
+ ********************************************************************************/
+static void timeline_finish(driver_node_t *node)
+{
+    xanime_timeline_t *tl = (xanime_timeline_t *)node;
+    tl->is_playing = false;
+    if (tl->complete_cb)
+    {
+        lv_anim_t a;
+        lv_anim_init(&a);
+        a.var = tl;
+        a.user_data = tl->user_data;
+        tl->complete_cb(&a);
+    }
+}
+
+/********************************************************************************
+ * @brief: 添加动画属性
+ * @param {lv_anim_t*} anim
+ * @param {lv_anim_exec_xcb_t} exec_cb
+ * @param {int32_t} start
+ * @param {const char*} end 整数字符串
+ * @return {*}
+ ********************************************************************************/
+void add_anim_property(xanime_t *anime, lv_anim_t *anim, lv_anim_exec_xcb_t exec_cb, int32_t start, const char *end)
+{
+    bool success = false;
+    int32_t end_int = str_to_int32(end, &success);
+    if (!success)
+    {
+        printf("Error: Invalid end value '%s'\n", end);
+        return;
+    }
+    anim_property_start(anime, anim, exec_cb, start, end_int);
+}
+
+/********************************************************************************
+ * @brief: 按已解析的起止值启动属性动画
+ * @param {xanime_t*} anime
+ * @param {lv_anim_t*} anim
+ * @param {lv_anim_exec_xcb_t} exec_cb
+ * @param {int32_t} start
+ * @param {int32_t} end
+ * @return {*}
+ ********************************************************************************/
+static void anim_property_start(xanime_t *anime, lv_anim_t *anim, lv_anim_exec_xcb_t exec_cb, int32_t start,
+                                int32_t end)
+{
+    lv_anim_set_exec_cb(anim, exec_cb);
+    if (anime->spec.is_from)
+    {
+        lv_anim_set_values(anim, end, start);
+    }
+    else
+    {
+        lv_anim_set_values(anim, start, end);
+    }
+
+    // 控制器持有的动画记录到控制器，完成回调时还原用户数据
+    anim_slot_t *slot = anime_slot_take(anime);
+    if (!slot)
+    {
+        // 记录用完时按自动播放处理，不能沿用上一个通道的记录
+        if (anim->deleted_cb == anime_slot_deleted_cb)
+        {
+            lv_anim_set_user_data(anim, anime->spec.user_data);
+            lv_anim_set_ready_cb(anim, anime->spec.complete_cb);
+            lv_anim_set_deleted_cb(anim, NULL);
+        }
+        lv_anim_start(anim);
+        return;
+    }
+    lv_anim_set_user_data(anim, slot);
+    lv_anim_set_ready_cb(anim, anime_slot_ready_cb);
+    lv_anim_set_deleted_cb(anim, anime_slot_deleted_cb);
+    anime_slot_bind(slot, lv_anim_start(anim));
+}
+
+/********************************************************************************
+ * @brief: 将带单位的数值解析为对象上的实际值
+ * @param {xanime_prop_t} prop
+ * @param {geom_snapshot_t*} geom 百分比单位的参照尺寸
+ * @param {xanime_value_t} value
+ * @param {int32_t} cur 当前值，相对单位以此为基准
+ * @return {*}
+ ********************************************************************************/
+static int32_t resolve_value(xanime_prop_t prop, const geom_snapshot_t *geom, xanime_value_t value, int32_t cur)
+{
+    if (value.unit == XANIME_UNIT_REL)
+        return cur + value.value;
+    if (value.unit != XANIME_UNIT_PERCENT)
+        return value.value;
+
+    switch (prop)
+    {
+    case XANIME_PROP_X:
+        return get_x_percent(geom, value.value);
+    case XANIME_PROP_Y:
+        return get_y_percent(geom, value.value);
+    case XANIME_PROP_WIDTH:
+        return get_width_percent(geom, value.value);
+    case XANIME_PROP_HEIGHT:
+        return get_height_percent(geom, value.value);
+    case XANIME_PROP_PIVOT_X:
+        return geom->obj_w * value.value / 100;
+    case XANIME_PROP_PIVOT_Y:
+        return geom->obj_h * value.value / 100;
+    default:
+        // 其他通道按注册的参照值换算
+        return prop < ANIM_PROP_COUNT ? channel_table[prop].percent_ref * value.value / 100 : value.value;
+    }
+}
+
+/********************************************************************************
+ * @brief: 旋转动画回调函数
+ * @param {void*} var
+ * @param {int32_t} v
+ * @return {*}
+ ********************************************************************************/
+static void rotate_exec_cb(void *var, int32_t v)
+{
+    if (is_image_object(var))
+    {
+        lv_img_set_angle(var, v);
+    }
+    else
+    {
+        lv_obj_set_style_transform_rotation(var, v, LV_PART_MAIN);
+    }
+}
+
+/********************************************************************************
+ * @brief: 透明度动画回调函数
+ * @param {void*} var
+ * @param {int32_t} v
+ * @return {*}
+ ********************************************************************************/
+static void opa_exec_cb(void *var, int32_t v)
+{
+    lv_obj_set_style_opa(var, (lv_opa_t)v, LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 缩放动画回调函数
+ * @param {void*} var
+ * @param {int32_t} v
+ * @return {*}
+ ********************************************************************************/
+static void zoom_exec_cb(void *var, int32_t v)
+{
+    lv_obj_set_style_transform_scale_x(var, v, LV_PART_MAIN);
+    lv_obj_set_style_transform_scale_y(var, v, LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 水平位置 translate 回调函数，不修改对象坐标
+ * @param {void*} var
+ * @param {int32_t} v
+ * @return {*}
+ ********************************************************************************/
+static void translate_x_exec_cb(void *var, int32_t v)
+{
+    lv_obj_set_style_translate_x(var, v, LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 垂直位置 translate 回调函数，不修改对象坐标
+ * @param {void*} var
+ * @param {int32_t} v
+ * @return {*}
+ ********************************************************************************/
+static void translate_y_exec_cb(void *var, int32_t v)
+{
+    lv_obj_set_style_translate_y(var, v, LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 背景颜色回调函数，v 为 0xRRGGBB
+ * @param {void*} var
+ * @param {int32_t} v
+ * @return {*}
+ ********************************************************************************/
+static void bg_color_exec_cb(void *var, int32_t v)
+{
+    lv_obj_set_style_bg_color(var, lv_color_hex((uint32_t)v), LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 边框颜色回调函数，v 为 0xRRGGBB
+ * @param {void*} var
+ * @param {int32_t} v
+ * @return {*}
+ ********************************************************************************/
+static void border_color_exec_cb(void *var, int32_t v)
+{
+    lv_obj_set_style_border_color(var, lv_color_hex((uint32_t)v), LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 文字颜色回调函数，v 为 0xRRGGBB
+ * @param {void*} var
+ * @param {int32_t} v
+ * @return {*}
+ ********************************************************************************/
+static void text_color_exec_cb(void *var, int32_t v)
+{
+    lv_obj_set_style_text_color(var, lv_color_hex((uint32_t)v), LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 边框宽度回调函数
+ * @param {void*} var
+ * @param {int32_t} v
+ * @return {*}
+ ********************************************************************************/
+static void border_width_exec_cb(void *var, int32_t v)
+{
+    lv_obj_set_style_border_width(var, v, LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 阴影宽度回调函数
+ * @param {void*} var
+ * @param {int32_t} v
+ * @return {*}
+ ********************************************************************************/
+static void shadow_width_exec_cb(void *var, int32_t v)
+{
+    lv_obj_set_style_shadow_width(var, v, LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 字间距回调函数
+ * @param {void*} var
+ * @param {int32_t} v
+ * @return {*}
+ ********************************************************************************/
+static void letter_space_exec_cb(void *var, int32_t v)
+{
+    lv_obj_set_style_text_letter_space(var, v, LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 读取 x 坐标
+ * @param {lv_obj_t*} obj
+ * @return {*}
+ ********************************************************************************/
+static int32_t x_get(lv_obj_t *obj)
+{
+    return lv_obj_get_x(obj);
+}
+
+/********************************************************************************
+ * @brief: 读取 y 坐标
+ * @param {lv_obj_t*} obj
+ * @return {*}
+ ********************************************************************************/
+static int32_t y_get(lv_obj_t *obj)
+{
+    return lv_obj_get_y(obj);
+}
+
+/********************************************************************************
+ * @brief: 读取宽度
+ * @param {lv_obj_t*} obj
+ * @return {*}
+ ********************************************************************************/
+static int32_t width_get(lv_obj_t *obj)
+{
+    return lv_obj_get_width(obj);
+}
+
+/********************************************************************************
+ * @brief: 读取高度
+ * @param {lv_obj_t*} obj
+ * @return {*}
+ ********************************************************************************/
+static int32_t height_get(lv_obj_t *obj)
+{
+    return lv_obj_get_height(obj);
+}
+
+/********************************************************************************
+ * @brief: 读取透明度
+ * @param {lv_obj_t*} obj
+ * @return {*}
+ ********************************************************************************/
+static int32_t opa_get(lv_obj_t *obj)
+{
+    return lv_obj_get_style_opa(obj, LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 读取旋转角度
+ * @param {lv_obj_t*} obj
+ * @return {*}
+ ********************************************************************************/
+static int32_t rotate_get(lv_obj_t *obj)
+{
+    return lv_obj_get_style_transform_angle(obj, LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 读取缩放
+ * @param {lv_obj_t*} obj
+ * @return {*}
+ ********************************************************************************/
+static int32_t scale_get(lv_obj_t *obj)
+{
+    return lv_obj_get_style_transform_scale_x(obj, LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 读取背景颜色
+ * @param {lv_obj_t*} obj
+ * @return {*}
+ ********************************************************************************/
+static int32_t bg_color_get(lv_obj_t *obj)
+{
+    return (int32_t)(lv_color_to_u32(lv_obj_get_style_bg_color(obj, LV_PART_MAIN)) & 0xFFFFFF);
+}
+
+/********************************************************************************
+ * @brief: 读取边框颜色
+ * @param {lv_obj_t*} obj
+ * @return {*}
+ ********************************************************************************/
+static int32_t border_color_get(lv_obj_t *obj)
+{
+    return (int32_t)(lv_color_to_u32(lv_obj_get_style_border_color(obj, LV_PART_MAIN)) & 0xFFFFFF);
+}
+
+/********************************************************************************
+ * @brief: 读取文字颜色
+ * @param {lv_obj_t*} obj
+ * @return {*}
+ ********************************************************************************/
+static int32_t text_color_get(lv_obj_t *obj)
+{
+    return (int32_t)(lv_color_to_u32(lv_obj_get_style_text_color(obj, LV_PART_MAIN)) & 0xFFFFFF);
+}
+
+/********************************************************************************
+ * @brief: 读取边框宽度
+ * @param {lv_obj_t*} obj
+ * @return {*}
+ ********************************************************************************/
+static int32_t border_width_get(lv_obj_t *obj)
+{
+    return lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 读取阴影宽度
+ * @param {lv_obj_t*} obj
+ * @return {*}
+ ********************************************************************************/
+static int32_t shadow_width_get(lv_obj_t *obj)
+{
+    return lv_obj_get_style_shadow_width(obj, LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 读取 x 方向平移
+ * @param {lv_obj_t*} obj
+ * @return {*}
+ ********************************************************************************/
+static int32_t translate_x_get(lv_obj_t *obj)
+{
+    return lv_obj_get_style_translate_x(obj, LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 读取 y 方向平移
+ * @param {lv_obj_t*} obj
+ * @return {*}
+ ********************************************************************************/
+static int32_t translate_y_get(lv_obj_t *obj)
+{
+    return lv_obj_get_style_translate_y(obj, LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 读取字间距
+ * @param {lv_obj_t*} obj
+ * @return {*}
+ ********************************************************************************/
+static int32_t letter_space_get(lv_obj_t *obj)
+{
+    return lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 宽度缩放回调函数，按已提交的真实宽度计算缩放
+ * @param {void*} var
+ * @param {int32_t} v
+ * @return {*}
+ ********************************************************************************/
+static void flip_width_exec_cb(void *var, int32_t v)
+{
+    int32_t base = lv_obj_get_style_width(var, LV_PART_MAIN);
+    // 基准或目标为 0 时无法缩放，直接修改尺寸
+    if (v <= 0 || base <= 0)
+    {
+        lv_obj_set_style_transform_scale_x(var, LV_SCALE_NONE, LV_PART_MAIN);
+        if (v != base)
+            lv_obj_set_width(var, v);
+        return;
+    }
+    lv_obj_set_style_transform_scale_x(var, (int32_t)((int64_t)v * LV_SCALE_NONE / base), LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 高度缩放回调函数，按已提交的真实高度计算缩放
+ * @param {void*} var
+ * @param {int32_t} v
+ * @return {*}
+ ********************************************************************************/
+static void flip_height_exec_cb(void *var, int32_t v)
+{
+    int32_t base = lv_obj_get_style_height(var, LV_PART_MAIN);
+    if (v <= 0 || base <= 0)
+    {
+        lv_obj_set_style_transform_scale_y(var, LV_SCALE_NONE, LV_PART_MAIN);
+        if (v != base)
+            lv_obj_set_height(var, v);
+        return;
+    }
+    lv_obj_set_style_transform_scale_y(var, (int32_t)((int64_t)v * LV_SCALE_NONE / base), LV_PART_MAIN);
+}
+
+/********************************************************************************
+ * @brief: 判断动画描述能否使用代理图片 (快照或旋转帧)，位置与尺寸动画需要真实对象，不能使用
+ * @param {xanime_spec_t*} spec
+ * @return {*}
+ ********************************************************************************/
+static bool spec_snapshot(const xanime_spec_t *spec)
+{
+    uint32_t allowed = channel_kind_mask[XANIME_INVALIDATE_TRANSFORM];
+    uint32_t anim_mask = spec->mask & (XANIME_PROP_BIT(ANIM_PROP_COUNT) - 1);
+    if (anim_mask == 0 || (anim_mask & ~allowed) != 0)
+        return false;
+    bool usable = false;
+#if LV_USE_SNAPSHOT
+    usable = usable || spec->snapshot;
+#endif
+#if LV_USE_CANVAS
+    usable = usable || (spec->sprite_frames > 0 && (anim_mask & XANIME_PROP_BIT(XANIME_PROP_ROTATE)));
+#endif
+    return usable;
+}
+
+#if PROXY_ENABLE
+// 所有快照与旋转帧已占用的字节数
+static uint32_t snapshot_used;
+#endif
+
+/********************************************************************************
+ * @brief: 用同位置的代理图片代替对象显示，图片对象的旋转优先使用预渲染的旋转帧
+ * @param {snapshot_t*} snap
+ * @param {lv_obj_t*} obj
+ * @param {bool} bitmap 允许把对象渲染为快照
+ * @param {uint8_t} sprite_frames 旋转帧数量，0 表示不使用
+ * @return {*} 动画应作用的对象，超出内存预算或渲染失败时为原对象
+ ********************************************************************************/
+static lv_obj_t *snapshot_begin(snapshot_t *snap, lv_obj_t *obj, bool bitmap, uint8_t sprite_frames)
+{
+    snap->obj = obj;
+    snap->proxy = NULL;
+    snap->buf = NULL;
+    snap->sprite = NULL;
+    lv_obj_t *proxy = NULL;
+#if LV_USE_CANVAS
+    if (sprite_frames > 0 && is_image_object(obj))
+        proxy = sprite_begin(snap, obj, sprite_frames);
+#else
+    LV_UNUSED(sprite_frames);
+#endif
+#if LV_USE_SNAPSHOT
+    if (!proxy && bitmap)
+        proxy = snapshot_render(snap, obj);
+#else
+    LV_UNUSED(bitmap);
+#endif
+    if (!proxy)
+        return obj;
+
+    // 紧贴在原对象之上，不改变与兄弟对象的层叠关系；原对象保持布局位置，只是不再绘制
+    lv_obj_add_flag(proxy, LV_OBJ_FLAG_IGNORE_LAYOUT);
+    lv_obj_move_to_index(proxy, lv_obj_get_index(obj) + 1);
+    opa_exec_cb(obj, LV_OPA_TRANSP);
+    lv_obj_add_event_cb(obj, snapshot_obj_delete_cb, LV_EVENT_DELETE, snap);
+    snap->proxy = proxy;
+    return proxy;
+}
+
+#if LV_USE_SNAPSHOT
+/********************************************************************************
+ * @brief: 把对象渲染为快照图片，当前的透明度与变换转移到图片上
+ * @param {snapshot_t*} snap
+ * @param {lv_obj_t*} obj
+ * @return {*} 快照图片，超出内存预算或渲染失败时为 NULL
+ ********************************************************************************/
+static lv_obj_t *snapshot_render(snapshot_t *snap, lv_obj_t *obj)
+{
+    // 快照包含阴影等扩展绘制区域
+    int32_t ext = lv_obj_get_ext_draw_size(obj);
+    uint32_t need = (uint32_t)(lv_obj_get_width(obj) + 2 * ext) * (uint32_t)(lv_obj_get_height(obj) + 2 * ext) * 4;
+    if (need > XANIME_SNAPSHOT_BUDGET - snapshot_used)
+        return NULL;
+
+    // 以不透明、无变换的状态渲染
+    int32_t opa = prop_get_value(XANIME_PROP_OPACITY, obj);
+    int32_t rotate = prop_get_value(XANIME_PROP_ROTATE, obj);
+    int32_t scale = prop_get_value(XANIME_PROP_SCALE, obj);
+    opa_exec_cb(obj, LV_OPA_COVER);
+    rotate_exec_cb(obj, 0);
+    zoom_exec_cb(obj, LV_SCALE_NONE);
+    snap->buf = lv_snapshot_take(obj, LV_COLOR_FORMAT_ARGB8888);
+    if (!snap->buf)
+    {
+        opa_exec_cb(obj, opa);
+        rotate_exec_cb(obj, rotate);
+        zoom_exec_cb(obj, scale);
+        return NULL;
+    }
+
+    lv_obj_t *proxy = lv_image_create(lv_obj_get_parent(obj));
+    lv_image_set_src(proxy, snap->buf);
+    lv_obj_set_pos(proxy, lv_obj_get_x(obj) - ext, lv_obj_get_y(obj) - ext);
+    int32_t pivot_x = lv_obj_get_style_transform_pivot_x(obj, LV_PART_MAIN) + ext;
+    int32_t pivot_y = lv_obj_get_style_transform_pivot_y(obj, LV_PART_MAIN) + ext;
+    lv_image_set_pivot(proxy, pivot_x, pivot_y);
+    lv_obj_set_style_transform_pivot_x(proxy, pivot_x, LV_PART_MAIN);
+    lv_obj_set_style_transform_pivot_y(proxy, pivot_y, LV_PART_MAIN);
+    opa_exec_cb(proxy, opa);
+    rotate_exec_cb(proxy, rotate);
+    zoom_exec_cb(proxy, scale);
+
+    snap->size = snap->buf->data_size;
+    snapshot_used += snap->size;
+    return proxy;
+}
+#endif
+
+#if LV_USE_CANVAS
+// 已渲染的旋转帧，相同图片、旋转中心与帧数的对象共用
+static sprite_t *sprite_list;
+
+/********************************************************************************
+ * @brief: 用预渲染的旋转帧代替图片对象显示，旋转只切换帧，不再逐帧重采样
+ * @param {snapshot_t*} snap
+ * @param {lv_obj_t*} obj 图片对象
+ * @param {uint8_t} frame_num
+ * @return {*} 显示旋转帧的图片，超出内存预算或渲染失败时为 NULL
+ ********************************************************************************/
+static lv_obj_t *sprite_begin(snapshot_t *snap, lv_obj_t *obj, uint8_t frame_num)
+{
+    const void *src = lv_image_get_src(obj);
+    lv_image_header_t header;
+    if (!src || lv_image_decoder_get_info(src, &header) != LV_RESULT_OK)
+        return NULL;
+    lv_point_t pivot;
+    lv_image_get_pivot(obj, &pivot);
+    if (LV_COORD_IS_PCT(pivot.x))
+        pivot.x = lv_pct_to_px(pivot.x, header.w);
+    if (LV_COORD_IS_PCT(pivot.y))
+        pivot.y = lv_pct_to_px(pivot.y, header.h);
+
+    sprite_t *sp = sprite_get(src, header.w, header.h, pivot, frame_num);
+    if (!sp)
+        return NULL;
+
+    // 旋转帧以旋转中心为中心，缩放也以此为中心
+    lv_obj_t *proxy = lv_image_create(lv_obj_get_parent(obj));
+    lv_obj_set_user_data(proxy, snap);
+    lv_obj_set_pos(proxy, lv_obj_get_x(obj) + pivot.x - sp->radius, lv_obj_get_y(obj) + pivot.y - sp->radius);
+    lv_obj_set_style_transform_pivot_x(proxy, sp->radius, LV_PART_MAIN);
+    lv_obj_set_style_transform_pivot_y(proxy, sp->radius, LV_PART_MAIN);
+    opa_exec_cb(proxy, prop_get_value(XANIME_PROP_OPACITY, obj));
+    zoom_exec_cb(proxy, prop_get_value(XANIME_PROP_SCALE, obj));
+    snap->sprite = sp;
+    sprite_exec_cb(proxy, lv_image_get_rotation(obj));
+    return proxy;
+}
+
+/********************************************************************************
+ * @brief: 获取旋转帧，没有可共用的旋转帧时渲染
+ * @param {void*} src 图片源
+ * @param {int32_t} w 图片宽度
+ * @param {int32_t} h 图片高度
+ * @param {lv_point_t} pivot 旋转中心
+ * @param {uint8_t} frame_num
+ * @return {*} 超出内存预算或渲染失败时为 NULL
+ ********************************************************************************/
+static sprite_t *sprite_get(const void *src, int32_t w, int32_t h, lv_point_t pivot, uint8_t frame_num)
+{
+    for (sprite_t *sp = sprite_list; sp; sp = sp->next)
+    {
+        if (sp->src == src && sp->frame_num == frame_num && sp->pivot.x == pivot.x && sp->pivot.y == pivot.y)
+        {
+            sp->ref_cnt++;
+            return sp;
+        }
+    }
+
+    // 帧的边长为旋转中心到最远角距离的两倍，任意角度都不会裁剪
+    int32_t dx = LV_MAX(pivot.x, w - pivot.x);
+    int32_t dy = LV_MAX(pivot.y, h - pivot.y);
+    uint32_t d2 = (uint32_t)(dx * dx + dy * dy);
+    int32_t radius = 0;
+    for (uint32_t bit = 1u << 15; bit; bit >>= 1)
+    {
+        if ((uint32_t)(radius | bit) * (uint32_t)(radius | bit) <= d2)
+            radius |= bit;
+    }
+    if ((uint32_t)radius * (uint32_t)radius < d2)
+        radius++;
+    int32_t side = radius * 2;
+    uint32_t need = (uint32_t)side * (uint32_t)side * 4 * frame_num;
+    if (need > XANIME_SNAPSHOT_BUDGET - snapshot_used)
+        return NULL;
+
+    sprite_t *sp = XANIME_MALLOC(sizeof(sprite_t) + frame_num * sizeof(lv_draw_buf_t *));
+    if (!sp)
+        return NULL;
+    memset(sp, 0, sizeof(sprite_t) + frame_num * sizeof(lv_draw_buf_t *));
+    sp->src = src;
+    sp->pivot = pivot;
+    sp->radius = radius;
+    sp->frame_num = frame_num;
+    sp->frames = (lv_draw_buf_t **)(sp + 1);
+
+    // 用画布逐帧绘制旋转后的图片，只在第一次使用时执行
+    lv_obj_t *canvas = lv_canvas_create(lv_screen_active());
+    lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+    lv_area_t coords = {radius - pivot.x, radius - pivot.y, radius - pivot.x + w - 1, radius - pivot.y + h - 1};
+    for (uint8_t k = 0; k < frame_num; k++)
+    {
+        sp->frames[k] = lv_draw_buf_create(side, side, LV_COLOR_FORMAT_ARGB8888, 0);
+        if (!sp->frames[k])
+            break;
+        sp->size += sp->frames[k]->data_size;
+        lv_canvas_set_draw_buf(canvas, sp->frames[k]);
+        lv_canvas_fill_bg(canvas, lv_color_black(), LV_OPA_TRANSP);
+
+        lv_layer_t layer;
+        lv_canvas_init_layer(canvas, &layer);
+        lv_draw_image_dsc_t dsc;
+        lv_draw_image_dsc_init(&dsc);
+        dsc.src = src;
+        dsc.rotation = (int32_t)(3600 * k / frame_num);
+        dsc.pivot = pivot;
+        dsc.antialias = 1;
+        lv_draw_image(&layer, &dsc, &coords);
+        lv_canvas_finish_layer(canvas, &layer);
+    }
+    lv_obj_delete(canvas);
+
+    snapshot_used += sp->size;
+    sp->ref_cnt = 1;
+    sp->next = sprite_list;
+    sprite_list = sp;
+    if (!sp->frames[frame_num - 1])
+    {
+        sprite_put(sp);
+        return NULL;
+    }
+    return sp;
+}
+
+/********************************************************************************
+ * @brief: 释放旋转帧的引用，没有对象使用时释放所有帧
+ * @param {sprite_t*} sp
+ * @return {*}
+ ********************************************************************************/
+static void sprite_put(sprite_t *sp)
+{
+    if (--sp->ref_cnt > 0)
+        return;
+    for (sprite_t **pp = &sprite_list; *pp; pp = &(*pp)->next)
+    {
+        if (*pp == sp)
+        {
+            *pp = sp->next;
+            break;
+        }
+    }
+    for (uint8_t k = 0; k < sp->frame_num; k++)
+    {
+        if (sp->frames[k])
+            lv_draw_buf_destroy(sp->frames[k]);
+    }
+    snapshot_used -= sp->size;
+    XANIME_FREE(sp);
+}
+
+/********************************************************************************
+ * @brief: 旋转帧动画回调函数，切换到最接近角度的帧
+ * @param {void*} var 显示旋转帧的图片
+ * @param {int32_t} v 角度 (0.1 度)
+ * @return {*}
+ ********************************************************************************/
+static void sprite_exec_cb(void *var, int32_t v)
+{
+    snapshot_t *snap = lv_obj_get_user_data(var);
+    const sprite_t *sp = snap->sprite;
+    snap->angle = v;
+    int32_t a = v % 3600;
+    if (a < 0)
+        a += 3600;
+    uint32_t k = ((uint32_t)a * sp->frame_num + 1800) / 3600 % sp->frame_num;
+    if (lv_image_get_src(var) != sp->frames[k])
+        lv_image_set_src(var, sp->frames[k]);
+}
+#endif
+
+/********************************************************************************
+ * @brief: 结束代理显示，把透明度与变换还给原对象并释放快照
+ * @param {snapshot_t*} snap
+ * @return {*}
+ ********************************************************************************/
+static void snapshot_end(snapshot_t *snap)
+{
+#if PROXY_ENABLE
+    lv_obj_t *proxy = snap->proxy;
+    if (!proxy)
+        return;
+    snap->proxy = NULL;
+    if (snap->obj)
+    {
+        lv_obj_remove_event_cb_with_user_data(snap->obj, snapshot_obj_delete_cb, snap);
+        opa_exec_cb(snap->obj, lv_obj_get_style_opa(proxy, LV_PART_MAIN));
+        rotate_exec_cb(snap->obj, snap->sprite ? snap->angle : lv_image_get_rotation(proxy));
+        zoom_exec_cb(snap->obj, lv_obj_get_style_transform_scale_x(proxy, LV_PART_MAIN));
+    }
+    lv_image_set_src(proxy, NULL);
+#if LV_USE_CANVAS
+    if (snap->sprite)
+        sprite_put(snap->sprite);
+    snap->sprite = NULL;
+#endif
+#if LV_USE_SNAPSHOT
+    if (snap->buf)
+    {
+        lv_draw_buf_destroy(snap->buf);
+        snapshot_used -= snap->size;
+    }
+    snap->buf = NULL;
+#endif
+    // 删除图片会删除作用在它上面的动画并释放 snap，之后不再访问
+    lv_obj_delete(proxy);
+#else
+    LV_UNUSED(snap);
+#endif
+}
+
+/********************************************************************************
+ * @brief: 原对象被删除时一并删除代理图片
+ * @param {lv_event_t*} e
+ * @return {*}
+ ********************************************************************************/
+static void snapshot_obj_delete_cb(lv_event_t *e)
+{
+    snapshot_t *snap = lv_event_get_user_data(e);
+    snap->obj = NULL;
+    snapshot_end(snap);
+}
+
+/********************************************************************************
+ * @brief: 判断对象是否为图片对象
+ * @param {lv_obj_t} *obj
+ * @return {*}
+ ********************************************************************************/
+static bool is_image_object(lv_obj_t *obj)
+{
+    return lv_obj_has_class(obj, &lv_image_class);
+}
+
+#if XANIME_EASING_CUSTOM_NUM > 8
+#error "XANIME_EASING_CUSTOM_NUM must not exceed 8"
+#endif
+
+// 缓动查找表: 对 IN 曲线在 [0, 1] 上等距采样，值为 Q10 (1024 = 1.0)，由 Penner 公式离线生成
+// OUT 与 IN_OUT 由对称关系得到: out(t) = 1 - in(1 - t)，in_out(t) = t < 0.5 ? in(2t) / 2 : 1 - in(2 - 2t) / 2
+// 线性插值与公式的最大误差 (test/bench_ease.c)：弹性 IN / OUT 在终点附近约 3.5 / 1024，其余曲线小于 2 / 1024，运行时没有浮点运算
+#define EASE_LUT_SHIFT 7
+#define EASE_LUT_SIZE ((1 << EASE_LUT_SHIFT) + 1)
+// 回弹在落地点不可导，使用更密的采样
+#define EASE_BOUNCE_LUT_SHIFT 9
+
+static const int16_t ease_lut_sine[EASE_LUT_SIZE] = {
+    0, 0, 0, 1, 1, 2, 3, 4, 5, 6, 8, 9, 11, 13, 15, 17,
+    20, 22, 25, 28, 31, 34, 37, 41, 44, 48, 52, 56, 60, 64, 69, 73,
+    78, 83, 88, 93, 98, 104, 109, 115, 121, 127, 133, 139, 146, 152, 159, 166,
+    173, 180, 187, 194, 202, 209, 217, 225, 232, 240, 249, 257, 265, 274, 282, 291,
+    300, 309, 318, 327, 336, 346, 355, 365, 374, 384, 394, 404, 414, 424, 434, 445,
+    455, 466, 476, 487, 498, 508, 519, 530, 541, 552, 564, 575, 586, 598, 609, 621,
+    632, 644, 655, 667, 679, 691, 703, 715, 727, 739, 751, 763, 775, 787, 800, 812,
+    824, 837, 849, 861, 874, 886, 899, 911, 924, 936, 949, 961, 974, 986, 999, 1011,
+    1024,
+};
+
+static const int16_t ease_lut_quad[EASE_LUT_SIZE] = {
+    0, 0, 0, 1, 1, 2, 2, 3, 4, 5, 6, 8, 9, 11, 12, 14,
+    16, 18, 20, 23, 25, 28, 30, 33, 36, 39, 42, 46, 49, 53, 56, 60,
+    64, 68, 72, 77, 81, 86, 90, 95, 100, 105, 110, 116, 121, 127, 132, 138,
+    144, 150, 156, 163, 169, 176, 182, 189, 196, 203, 210, 218, 225, 233, 240, 248,
+    256, 264, 272, 281, 289, 298, 306, 315, 324, 333, 342, 352, 361, 371, 380, 390,
+    400, 410, 420, 431, 441, 452, 462, 473, 484, 495, 506, 518, 529, 541, 552, 564,
+    576, 588, 600, 613, 625, 638, 650, 663, 676, 689, 702, 716, 729, 743, 756, 770,
+    784, 798, 812, 827, 841, 856, 870, 885, 900, 915, 930, 946, 961, 977, 992, 1008,
+    1024,
+};
+
+static const int16_t ease_lut_cubic[EASE_LUT_SIZE] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2,
+    2, 2, 3, 3, 4, 5, 5, 6, 7, 8, 9, 10, 11, 12, 13, 15,
+    16, 18, 19, 21, 23, 25, 27, 29, 31, 34, 36, 39, 42, 44, 48, 51,
+    54, 57, 61, 65, 69, 73, 77, 81, 86, 90, 95, 100, 105, 111, 116, 122,
+    128, 134, 140, 147, 154, 160, 167, 175, 182, 190, 198, 206, 214, 223, 232, 241,
+    250, 259, 269, 279, 289, 300, 311, 322, 333, 344, 356, 368, 380, 393, 406, 419,
+    432, 446, 460, 474, 488, 503, 518, 534, 549, 565, 582, 598, 615, 632, 650, 668,
+    686, 705, 723, 743, 762, 782, 802, 823, 844, 865, 887, 909, 931, 954, 977, 1000,
+    1024,
+};
+
+static const int16_t ease_lut_quart[EASE_LUT_SIZE] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 2, 2, 2, 3, 3, 4,
+    4, 5, 5, 6, 6, 7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19,
+    20, 22, 24, 26, 28, 30, 32, 35, 38, 40, 43, 46, 49, 53, 56, 60,
+    64, 68, 72, 77, 82, 86, 92, 97, 103, 108, 114, 121, 127, 134, 141, 149,
+    156, 164, 172, 181, 190, 199, 209, 219, 229, 239, 250, 262, 273, 285, 298, 311,
+    324, 338, 352, 366, 381, 397, 413, 429, 446, 464, 482, 500, 519, 538, 559, 579,
+    600, 622, 644, 667, 691, 715, 740, 765, 791, 818, 845, 873, 902, 931, 961, 992,
+    1024,
+};
+
+static const int16_t ease_lut_back[EASE_LUT_SIZE] = {
+    0, 0, 0, -1, -2, -2, -4, -5, -6, -8, -9, -11, -13, -15, -17, -19,
+    -22, -24, -27, -29, -32, -35, -37, -40, -43, -46, -49, -52, -54, -57, -60, -63,
+    -66, -68, -71, -74, -76, -79, -81, -84, -86, -88, -90, -92, -94, -95, -97, -98,
+    -99, -100, -101, -102, -102, -102, -102, -102, -102, -101, -100, -99, -98, -96, -94, -92,
+    -90, -87, -84, -81, -77, -73, -69, -64, -59, -54, -48, -42, -35, -28, -21, -13,
+    -5, 3, 12, 22, 31, 42, 52, 64, 75, 88, 100, 113, 127, 141, 156, 171,
+    187, 203, 220, 238, 256, 274, 293, 313, 334, 355, 376, 398, 421, 445, 469, 494,
+    519, 545, 572, 600, 628, 657, 687, 717, 748, 780, 812, 846, 880, 915, 950, 987,
+    1024,
+};
+
+static const int16_t ease_lut_back_in_out[EASE_LUT_SIZE] = {
+    0, 0, -1, -1, -2, -4, -5, -7, -9, -12, -14, -17, -20, -24, -27, -31,
+    -34, -38, -42, -47, -51, -55, -60, -64, -69, -74, -79, -84, -89, -94, -99, -104,
+    -109, -114, -118, -123, -128, -133, -138, -143, -147, -152, -156, -160, -164, -168, -172, -176,
+    -180, -183, -186, -189, -192, -194, -197, -199, -200, -202, -203, -204, -205, -205, -205, -205,
+    -204, -203, -202, -200, -198, -196, -193, -189, -186, -181, -177, -172, -166, -160, -154, -147,
+    -139, -131, -123, -114, -104, -94, -83, -72, -60, -47, -34, -20, -6, 9, 25, 41,
+    58, 76, 95, 114, 134, 154, 175, 198, 220, 244, 268, 294, 320, 346, 374, 402,
+    432, 462, 493, 525, 558, 591, 626, 661, 698, 735, 773, 813, 853, 894, 937, 980,
+    1024,
+};
+
+static const int16_t ease_lut_elastic[EASE_LUT_SIZE] = {
+    0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 1, 1, 1, 0, 0, -1, -2, -2, -3, -4, -4, -5, -5,
+    -6, -6, -6, -6, -6, -5, -4, -3, -2, -1, 1, 2, 4, 6, 8, 10,
+    12, 13, 15, 16, 17, 17, 17, 16, 15, 13, 10, 7, 3, -1, -6, -11,
+    -16, -21, -27, -32, -37, -41, -44, -47, -48, -47, -46, -42, -37, -30, -22, -12,
+    0, 13, 27, 42, 58, 73, 88, 101, 113, 123, 131, 134, 135, 131, 122, 109,
+    91, 67, 39, 7, -29, -69, -111, -154, -197, -240, -279, -314, -344, -366, -379, -382,
+    -373, -351, -316, -267, -205, -128, -39, 62, 172, 289, 411, 534, 654, 768, 870, 957,
+    1024,
+};
+
+static const int16_t ease_lut_elastic_in_out[EASE_LUT_SIZE] = {
+    0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 0, 0, -1, -2, -2,
+    -3, -4, -4, -5, -6, -7, -7, -8, -9, -9, -10, -10, -10, -11, -11, -11,
+    -10, -10, -9, -8, -7, -6, -4, -2, 0, 2, 5, 8, 11, 14, 17, 21,
+    25, 28, 32, 35, 38, 41, 44, 47, 49, 50, 51, 51, 50, 49, 46, 43,
+    38, 32, 26, 17, 8, -2, -14, -26, -40, -55, -70, -86, -103, -120, -137, -154,
+    -170, -186, -200, -213, -224, -233, -239, -242, -242, -238, -229, -217, -199, -176, -148, -114,
+    -75, -30, 21, 77, 138, 205, 275, 349, 427, 506, 587, 668, 747, 824, 897, 964,
+    1024,
+};
+
+static const int16_t ease_lut_bounce[(1 << EASE_BOUNCE_LUT_SHIFT) + 1] = {
+    0, 1, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 12, 13, 13, 14,
+    14, 15, 15, 15, 16, 16, 16, 16, 16, 16, 16, 16, 15, 15, 15, 14,
+    14, 13, 13, 12, 11, 10, 10, 9, 8, 7, 6, 5, 3, 2, 1, 1,
+    4, 7, 9, 12, 14, 17, 19, 21, 23, 26, 28, 30, 32, 34, 35, 37,
+    39, 41, 42, 44, 45, 47, 48, 50, 51, 52, 53, 54, 55, 56, 57, 58,
+    59, 60, 60, 61, 62, 62, 63, 63, 63, 64, 64, 64, 64, 64, 64, 64,
+    64, 64, 63, 63, 63, 62, 62, 61, 60, 60, 59, 58, 57, 57, 56, 55,
+    53, 52, 51, 50, 48, 47, 46, 44, 43, 41, 39, 38, 36, 34, 32, 30,
+    28, 26, 24, 22, 19, 17, 15, 12, 10, 7, 4, 2, 2, 7, 13, 18,
+    23, 29, 34, 39, 44, 49, 54, 59, 63, 68, 73, 78, 82, 87, 91, 95,
+    100, 104, 108, 112, 116, 120, 124, 128, 132, 136, 140, 143, 147, 151, 154, 158,
+    161, 164, 168, 171, 174, 177, 180, 183, 186, 189, 191, 194, 197, 200, 202, 205,
+    207, 209, 212, 214, 216, 218, 220, 222, 224, 226, 228, 230, 232, 233, 235, 236,
+    238, 239, 241, 242, 243, 245, 246, 247, 248, 249, 250, 250, 251, 252, 253, 253,
+    254, 254, 255, 255, 255, 256, 256, 256, 256, 256, 256, 256, 256, 255, 255, 255,
+    254, 254, 253, 253, 252, 252, 251, 250, 249, 248, 247, 246, 245, 244, 243, 241,
+    240, 239, 237, 236, 234, 232, 231, 229, 227, 225, 223, 221, 219, 217, 215, 213,
+    210, 208, 206, 203, 201, 198, 195, 193, 190, 187, 184, 181, 178, 175, 172, 169,
+    166, 162, 159, 156, 152, 149, 145, 141, 138, 134, 130, 126, 122, 118, 114, 110,
+    106, 102, 97, 93, 89, 84, 80, 75, 70, 66, 61, 56, 51, 46, 41, 36,
+    31, 26, 21, 15, 10, 4, 2, 13, 24, 35, 45, 56, 67, 77, 88, 99,
+    109, 119, 130, 140, 150, 160, 170, 180, 190, 200, 210, 220, 229, 239, 249, 258,
+    268, 277, 287, 296, 305, 314, 323, 332, 341, 350, 359, 368, 377, 386, 394, 403,
+    411, 420, 428, 437, 445, 453, 461, 470, 478, 486, 494, 501, 509, 517, 525, 532,
+    540, 548, 555, 562, 570, 577, 584, 591, 599, 606, 613, 620, 626, 633, 640, 647,
+    653, 660, 667, 673, 679, 686, 692, 698, 704, 711, 717, 723, 729, 734, 740, 746,
+    752, 757, 763, 768, 774, 779, 785, 790, 795, 800, 806, 811, 816, 820, 825, 830,
+    835, 840, 844, 849, 853, 858, 862, 867, 871, 875, 879, 883, 887, 891, 895, 899,
+    903, 907, 910, 914, 918, 921, 925, 928, 931, 935, 938, 941, 944, 947, 950, 953,
+    956, 959, 961, 964, 967, 969, 972, 974, 977, 979, 981, 984, 986, 988, 990, 992,
+    994, 996, 997, 999, 1001, 1002, 1004, 1006, 1007, 1008, 1010, 1011, 1012, 1013, 1014, 1015,
+    1016, 1017, 1018, 1019, 1020, 1020, 1021, 1022, 1022, 1023, 1023, 1023, 1024, 1024, 1024, 1024,
+    1024,
+};
+// 缓动曲线的组合方式
+typedef enum
+{
+    EASE_KIND_IN,
+    EASE_KIND_OUT,
+    EASE_KIND_IN_OUT,
+} ease_kind_t;
+
+typedef struct
+{
+    // IN 曲线查找表，为 NULL 时为线性
+    const int16_t *lut;
+    uint8_t shift;
+    uint8_t kind;
+} ease_desc_t;
+
+// IN_OUT_BACK 与 IN_OUT_ELASTIC 按 Penner 公式使用不同的参数，单独采样
+static const ease_desc_t ease_descs[XANIME_EASE_COUNT] = {
+    [XANIME_EASE_LINEAR] = {NULL, 0, EASE_KIND_IN},
+    [XANIME_EASE_IN_SINE] = {ease_lut_sine, EASE_LUT_SHIFT, EASE_KIND_IN},
+    [XANIME_EASE_OUT_SINE] = {ease_lut_sine, EASE_LUT_SHIFT, EASE_KIND_OUT},
+    [XANIME_EASE_IN_OUT_SINE] = {ease_lut_sine, EASE_LUT_SHIFT, EASE_KIND_IN_OUT},
+    [XANIME_EASE_IN_QUAD] = {ease_lut_quad, EASE_LUT_SHIFT, EASE_KIND_IN},
+    [XANIME_EASE_OUT_QUAD] = {ease_lut_quad, EASE_LUT_SHIFT, EASE_KIND_OUT},
+    [XANIME_EASE_IN_OUT_QUAD] = {ease_lut_quad, EASE_LUT_SHIFT, EASE_KIND_IN_OUT},
+    [XANIME_EASE_IN_CUBIC] = {ease_lut_cubic, EASE_LUT_SHIFT, EASE_KIND_IN},
+    [XANIME_EASE_OUT_CUBIC] = {ease_lut_cubic, EASE_LUT_SHIFT, EASE_KIND_OUT},
+    [XANIME_EASE_IN_OUT_CUBIC] = {ease_lut_cubic, EASE_LUT_SHIFT, EASE_KIND_IN_OUT},
+    [XANIME_EASE_IN_QUART] = {ease_lut_quart, EASE_LUT_SHIFT, EASE_KIND_IN},
+    [XANIME_EASE_OUT_QUART] = {ease_lut_quart, EASE_LUT_SHIFT, EASE_KIND_OUT},
+    [XANIME_EASE_IN_OUT_QUART] = {ease_lut_quart, EASE_LUT_SHIFT, EASE_KIND_IN_OUT},
+    [XANIME_EASE_IN_BACK] = {ease_lut_back, EASE_LUT_SHIFT, EASE_KIND_IN},
+    [XANIME_EASE_OUT_BACK] = {ease_lut_back, EASE_LUT_SHIFT, EASE_KIND_OUT},
+    [XANIME_EASE_IN_OUT_BACK] = {ease_lut_back_in_out, EASE_LUT_SHIFT, EASE_KIND_IN_OUT},
+    [XANIME_EASE_IN_ELASTIC] = {ease_lut_elastic, EASE_LUT_SHIFT, EASE_KIND_IN},
+    [XANIME_EASE_OUT_ELASTIC] = {ease_lut_elastic, EASE_LUT_SHIFT, EASE_KIND_OUT},
+    [XANIME_EASE_IN_OUT_ELASTIC] = {ease_lut_elastic_in_out, EASE_LUT_SHIFT, EASE_KIND_IN_OUT},
+    [XANIME_EASE_IN_BOUNCE] = {ease_lut_bounce, EASE_BOUNCE_LUT_SHIFT, EASE_KIND_IN},
+    [XANIME_EASE_OUT_BOUNCE] = {ease_lut_bounce, EASE_BOUNCE_LUT_SHIFT, EASE_KIND_OUT},
+    [XANIME_EASE_IN_OUT_BOUNCE] = {ease_lut_bounce, EASE_BOUNCE_LUT_SHIFT, EASE_KIND_IN_OUT},
+};
+
+// 自定义贝塞尔缓动，注册时编译为与内置曲线相同的查找表
+static int16_t ease_custom_lut[XANIME_EASING_CUSTOM_NUM][EASE_LUT_SIZE];
+static uint8_t ease_custom_num;
+
+/********************************************************************************
+ * @brief: 查找表线性插值
+ * @param {int16_t*} lut
+ * @param {uint8_t} shift 查找表段数为 1 << shift
+ * @param {int32_t} t [0, XANIME_PROGRESS_MAX]
+ * @return {*}
+ ********************************************************************************/
+static int32_t ease_lut_eval(const int16_t *lut, uint8_t shift, int32_t t)
+{
+    uint32_t pos = (uint32_t)t << shift;
+    uint32_t i = pos >> XANIME_PROGRESS_SHIFT;
+    if (i >= ((uint32_t)1 << shift))
+        return lut[(uint32_t)1 << shift];
+    int32_t frac = (int32_t)(pos & (XANIME_PROGRESS_MAX - 1));
+    return lut[i] + (((lut[i + 1] - lut[i]) * frac) >> XANIME_PROGRESS_SHIFT);
+}
+
+/********************************************************************************
+ * @brief: 计算缓动曲线
+ * @param {uint32_t} easing 内置或自定义缓动
+ * @param {int32_t} t 线性进度 [0, XANIME_PROGRESS_MAX]
+ * @return {*} 缓动后的进度，回弹类缓动可能超出范围
+ ********************************************************************************/
+static int32_t ease_eval(uint32_t easing, int32_t t)
+{
+    if (t <= 0)
+        return 0;
+    if (t >= XANIME_PROGRESS_MAX)
+        return XANIME_PROGRESS_MAX;
+
+    if (easing >= XANIME_EASE_COUNT)
+    {
+        uint32_t idx = easing - XANIME_EASE_COUNT;
+        return idx < ease_custom_num ? ease_lut_eval(ease_custom_lut[idx], EASE_LUT_SHIFT, t) : t;
+    }
+
+    const ease_desc_t *desc = &ease_descs[easing];
+    if (!desc->lut)
+        return t;
+    switch (desc->kind)
+    {
+    case EASE_KIND_OUT:
+        return XANIME_PROGRESS_MAX - ease_lut_eval(desc->lut, desc->shift, XANIME_PROGRESS_MAX - t);
+    case EASE_KIND_IN_OUT:
+        if (t < XANIME_PROGRESS_MAX / 2)
+            return ease_lut_eval(desc->lut, desc->shift, t * 2) / 2;
+        return XANIME_PROGRESS_MAX - ease_lut_eval(desc->lut, desc->shift, (XANIME_PROGRESS_MAX - t) * 2) / 2;
+    default:
+        return ease_lut_eval(desc->lut, desc->shift, t);
+    }
+}
+
+/********************************************************************************
+ * @brief: lv_anim 路径回调的公共部分
+ * @param {lv_anim_t*} a
+ * @param {uint32_t} easing
+ * @return {*}
+ ********************************************************************************/
+static int32_t ease_path(const lv_anim_t *a, uint32_t easing)
+{
+    int32_t t = a->duration > 0 ? (int32_t)(((int64_t)a->act_time << XANIME_PROGRESS_SHIFT) / a->duration)
+                                : XANIME_PROGRESS_MAX;
+    int32_t progress = ease_eval(easing, t);
+    return a->start_value + (int32_t)(((int64_t)(a->end_value - a->start_value) * progress) >> XANIME_PROGRESS_SHIFT);
+}
+
+// lv_anim 的路径回调没有参数，每条曲线一个入口
+#define EASE_PATH_CB(name, easing) \
+    static int32_t name(const lv_anim_t *a) { return ease_path(a, easing); }
+
+EASE_PATH_CB(ease_path_in_sine, XANIME_EASE_IN_SINE)
+EASE_PATH_CB(ease_path_out_sine, XANIME_EASE_OUT_SINE)
+EASE_PATH_CB(ease_path_in_out_sine, XANIME_EASE_IN_OUT_SINE)
+EASE_PATH_CB(ease_path_in_quad, XANIME_EASE_IN_QUAD)
+EASE_PATH_CB(ease_path_out_quad, XANIME_EASE_OUT_QUAD)
+EASE_PATH_CB(ease_path_in_out_quad, XANIME_EASE_IN_OUT_QUAD)
+EASE_PATH_CB(ease_path_in_cubic, XANIME_EASE_IN_CUBIC)
+EASE_PATH_CB(ease_path_out_cubic, XANIME_EASE_OUT_CUBIC)
+EASE_PATH_CB(ease_path_in_out_cubic, XANIME_EASE_IN_OUT_CUBIC)
+EASE_PATH_CB(ease_path_in_quart, XANIME_EASE_IN_QUART)
+EASE_PATH_CB(ease_path_out_quart, XANIME_EASE_OUT_QUART)
+EASE_PATH_CB(ease_path_in_out_quart, XANIME_EASE_IN_OUT_QUART)
+EASE_PATH_CB(ease_path_in_back, XANIME_EASE_IN_BACK)
+EASE_PATH_CB(ease_path_out_back, XANIME_EASE_OUT_BACK)
+EASE_PATH_CB(ease_path_in_out_back, XANIME_EASE_IN_OUT_BACK)
+EASE_PATH_CB(ease_path_in_elastic, XANIME_EASE_IN_ELASTIC)
+EASE_PATH_CB(ease_path_out_elastic, XANIME_EASE_OUT_ELASTIC)
+EASE_PATH_CB(ease_path_in_out_elastic, XANIME_EASE_IN_OUT_ELASTIC)
+EASE_PATH_CB(ease_path_in_bounce, XANIME_EASE_IN_BOUNCE)
+EASE_PATH_CB(ease_path_out_bounce, XANIME_EASE_OUT_BOUNCE)
+EASE_PATH_CB(ease_path_in_out_bounce, XANIME_EASE_IN_OUT_BOUNCE)
+EASE_PATH_CB(ease_path_custom_0, XANIME_EASE_COUNT + 0)
+EASE_PATH_CB(ease_path_custom_1, XANIME_EASE_COUNT + 1)
+EASE_PATH_CB(ease_path_custom_2, XANIME_EASE_COUNT + 2)
+EASE_PATH_CB(ease_path_custom_3, XANIME_EASE_COUNT + 3)
+EASE_PATH_CB(ease_path_custom_4, XANIME_EASE_COUNT + 4)
+EASE_PATH_CB(ease_path_custom_5, XANIME_EASE_COUNT + 5)
+EASE_PATH_CB(ease_path_custom_6, XANIME_EASE_COUNT + 6)
+EASE_PATH_CB(ease_path_custom_7, XANIME_EASE_COUNT + 7)
+
+static const lv_anim_path_cb_t ease_path_cbs[XANIME_EASE_COUNT + 8] = {
+    lv_anim_path_linear,
+    ease_path_in_sine,
+    ease_path_out_sine,
+    ease_path_in_out_sine,
+    ease_path_in_quad,
+    ease_path_out_quad,
+    ease_path_in_out_quad,
+    ease_path_in_cubic,
+    ease_path_out_cubic,
+    ease_path_in_out_cubic,
+    ease_path_in_quart,
+    ease_path_out_quart,
+    ease_path_in_out_quart,
+    ease_path_in_back,
+    ease_path_out_back,
+    ease_path_in_out_back,
+    ease_path_in_elastic,
+    ease_path_out_elastic,
+    ease_path_in_out_elastic,
+    ease_path_in_bounce,
+    ease_path_out_bounce,
+    ease_path_in_out_bounce,
+    ease_path_custom_0,
+    ease_path_custom_1,
+    ease_path_custom_2,
+    ease_path_custom_3,
+    ease_path_custom_4,
+    ease_path_custom_5,
+    ease_path_custom_6,
+    ease_path_custom_7,
+};
+
+/********************************************************************************
+ * @brief: 检查缓动编号，无效的缓动按线性处理
+ * @param {xanime_easing_t} easing
+ * @return {*}
+ ********************************************************************************/
+static uint8_t ease_normalize(xanime_easing_t easing)
+{
+    if ((uint32_t)easing < XANIME_EASE_COUNT + (uint32_t)ease_custom_num)
+        return (uint8_t)easing;
+    return XANIME_EASE_LINEAR;
+}
+
+/********************************************************************************
+ * @brief: 获取缓动函数
+ * @param {xanime_easing_t} easing
+ * @return {*}
+ ********************************************************************************/
+static lv_anim_path_cb_t get_easing_func(xanime_easing_t easing)
+{
+    return ease_path_cbs[ease_normalize(easing)];
+}
+
+/********************************************************************************
+ * @brief: 三次贝塞尔曲线在一个轴上的值，端点为 0 和 1
+ * @param {int32_t} s 曲线参数，Q14
+ * @param {int32_t} p1 控制点 1，Q10
+ * @param {int32_t} p2 控制点 2，Q10
+ * @return {*} Q14
+ ********************************************************************************/
+static int32_t bezier_axis(int32_t s, int32_t p1, int32_t p2)
+{
+    int64_t si = (1 << 14) - s;
+    // 3(1-s)^2 s p1 + 3(1-s) s^2 p2 + s^3，各项为 Q52
+    int64_t v = 3 * si * si * s * p1 + 3 * si * s * s * p2 + (int64_t)s * s * s * XANIME_EASING_ONE;
+    return (int32_t)(v >> 38);
+}
+
+/********************************************************************************
+ * @brief: 注册 CSS cubic-bezier(x1, y1, x2, y2) 形式的自定义缓动，编译为查找表
+ * @param {int32_t} x1 控制点，XANIME_EASING_ONE 表示 1.0，x 在 [0, 1] 之间
+ * @param {int32_t} y1
+ * @param {int32_t} x2
+ * @param {int32_t} y2
+ * @return {*} 缓动编号，可用于 .easing 与关键帧；失败时返回 XANIME_EASE_LINEAR
+ ********************************************************************************/
+xanime_easing_t xanime_easing_bezier(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    if (x1 < 0 || x1 > XANIME_EASING_ONE || x2 < 0 || x2 > XANIME_EASING_ONE || y1 < INT16_MIN || y1 > INT16_MAX ||
+        y2 < INT16_MIN || y2 > INT16_MAX)
+    {
+        printf("Error: Invalid cubic-bezier control points\n");
+        return XANIME_EASE_LINEAR;
+    }
+    if (ease_custom_num >= XANIME_EASING_CUSTOM_NUM)
+    {
+        printf("Error: Too many custom easings, increase XANIME_EASING_CUSTOM_NUM\n");
+        return XANIME_EASE_LINEAR;
+    }
+
+    int16_t *lut = ease_custom_lut[ease_custom_num];
+    for (uint32_t i = 0; i < EASE_LUT_SIZE; i++)
+    {
+        // x 在 [0, 1] 上单调，二分求出对应的曲线参数
+        int32_t x = (int32_t)(i << (14 - EASE_LUT_SHIFT));
+        int32_t lo = 0;
+        int32_t hi = 1 << 14;
+        while (lo < hi)
+        {
+            int32_t mid = (lo + hi) / 2;
+            if (bezier_axis(mid, x1, x2) < x)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        int32_t y = bezier_axis(lo, y1, y2) >> 4;
+        lut[i] = (int16_t)(y < INT16_MIN ? INT16_MIN : (y > INT16_MAX ? INT16_MAX : y));
+    }
+
+    return (xanime_easing_t)(XANIME_EASE_COUNT + ease_custom_num++);
+}
+
+/********************************************************************************
+ * @brief: 字符串转换为int32_t
+ * @param {char*} str
+ * @param {bool*} success
+ * @return {*}
+ ********************************************************************************/
+static int32_t str_to_int32(const char *str, bool *success)
+{
+    if (!str || !str[0])
+    {
+        if (success)
+            *success = false;
+        return 0;
+    }
+
+    const char *p = str;
+    bool negative = false;
+    int32_t result = 0;
+
+    // 跳过前导空格
+    while (*p == ' ')
+        p++;
+
+    // 处理符号
+    if (*p == '-')
+    {
+        negative = true;
+        p++;
+    }
+    else if (*p == '+')
+    {
+        p++;
+    }
+
+    // 检查是否有有效数字
+    if (!isdigit((unsigned char)*p))
+    {
+        if (success)
+            *success = false;
+        return 0;
+    }
+
+    // 主转换循环
+    const int32_t MAX_SAFE = INT32_MAX / 10;
+    const int32_t LAST_DIGIT_MAX = INT32_MAX % 10;
+
+    while (*p)
+    {
+        if (!isdigit((unsigned char)*p))
+            break;
+
+        int digit = *p - '0';
+
+        // 溢出检查 (在乘以10之前)
+        if (result > MAX_SAFE || (result == MAX_SAFE && digit > (negative ? LAST_DIGIT_MAX + 1 : LAST_DIGIT_MAX)))
+        {
+            if (success)
+                *success = false;
+            return negative ? INT32_MIN : INT32_MAX;
+        }
 
-static int16_t get_height_percent(lv_obj_t *obj, char *percent);
+        result = result * 10 + digit;
+        p++;
+    }
 
-static void remove_percent_chars(char *str);
+    // 处理负值
+    if (negative)
+    {
+        result = -result;
+    }
 
-static bool has_percent(const char *str);
+    if (success)
+        *success = true;
+    return result;
+}
 
 /********************************************************************************
- * @brief: 创建单个动画
- * @param {lv_obj_t} obj
- * @param {xanime_param_t} params
- * @return {*}
+ * @brief: 获取控制器的组动画，尚未启动时先解析并停在起始状态
+ * @param {xanime_t*} anime
+ * @return {*} 不是组动画时返回 NULL
  ********************************************************************************/
-void xanime_create_single(lv_obj_t *obj, xanime_param_t params)
+static group_anim_t *anime_runner(xanime_t *anime)
 {
-    lv_obj_t *obj_arr[1] = {obj};
-    xanime_create((xanime_obj_t){.obj_num = 1, .obj_arr = obj_arr}, params);
+    if (!anime || !anime->obj.obj_arr || anime->obj.obj_num == 0)
+        return NULL;
+    if (ANIME_PRIV(anime)->runner)
+        return ANIME_PRIV(anime)->runner;
+
+    if (!spec_grouped(&anime->spec))
+    {
+        printf("Error: Playback control requires XANIME_MODE_GROUP\n");
+        return NULL;
+    }
+    refresh_layout(anime);
+    group_anim_t *g = group_build(anime, spec_needs_geom(&anime->spec));
+    if (!g)
+        return NULL;
+    group_capture(g);
+    group_seek(g, 0);
+    g->owner = anime;
+    ANIME_PRIV(anime)->runner = g;
+    return g;
 }
 
 /********************************************************************************
- * @brief: 创建并执行动画控制器
- * @param {xanime_obj_t} obj
- * @param {xanime_param_t} params
+ * @brief: 暂停动画，保留当前进度
+ * @param {xanime_t*} anime
  * @return {*}
  ********************************************************************************/
-void xanime_create(xanime_obj_t obj, xanime_param_t params)
+xanime_t *xanime_pause(xanime_t *anime)
 {
-    if (obj.obj_num == 0)
-        return;
-    bool success = false;
-    int32_t dur = str_to_int32(params.dur, &success);
-    if (!success || dur <= 0)
-        return;
-
-    xanime_t anime;
-    memset(&anime, 0, sizeof(xanime_t));
-
-    // 复制对象数组
-    anime.obj.obj_arr = obj.obj_arr;
-    anime.obj.obj_num = obj.obj_num;
-
-    anime.params.x = params.x;
-    anime.params.y = params.y;
-    anime.params.width = params.width;
-    anime.params.height = params.height;
-    anime.params.opacity = params.opacity;
-    anime.params.rotate = params.rotate;
-    anime.params.scale = params.scale;
-    anime.params.dur = params.dur;
-    anime.params.delay = params.delay;
-    anime.params.easing = params.easing;
-    anime.params.loop = params.loop;
-    anime.params.pivot_x = params.pivot_x;
-    anime.params.pivot_y = params.pivot_y;
-    anime.params.complete_cb = params.complete_cb;
-    anime.params.user_data = params.user_data;
-    anime.params.is_from = params.is_from;
-
-    // 初始化状态
-    anime.is_playing = false;
+    group_anim_t *g = anime_runner(anime);
+    if (!g)
+        return NULL;
 
-    // 自动播放
-    xanime_start(&anime);
+    group_stop(g);
+    anime->is_playing = false;
+    anime->is_paused = true;
+    return anime;
 }
 
 /********************************************************************************
- * @brief: 创建单个动画有返回值，返回动画控制器指针
- * @param {lv_obj_t*} obj
- * @param {xanime_param_t} params
+ * @brief: 从暂停处继续播放
+ * @param {xanime_t*} anime
  * @return {*}
  ********************************************************************************/
-xanime_t *xanime_create_single_rt(lv_obj_t *obj, xanime_param_t params)
+xanime_t *xanime_resume(xanime_t *anime)
 {
-    lv_obj_t *obj_arr[1] = {obj};
-    return xanime_create_rt((xanime_obj_t){.obj_num = 1, .obj_arr = obj_arr},
+    group_anim_t *g = anime_runner(anime);
+    if (!g)
+        return NULL;
+    if (!anime->is_paused)
+        return anime;
 
-                            params);
+    anime->is_paused = false;
+    anime->is_playing = true;
+    group_play(g);
+    return anime;
 }
 
 /********************************************************************************
- * @brief: 创建动画控制器有返回值，返回动画控制器指针
- * @param {xanime_obj_t} obj
- * @param {xanime_param_t} params
+ * @brief: 跳转到指定时间并立即应用，不改变播放或暂停状态
+ * @param {xanime_t*} anime
+ * @param {uint32_t} time 相对动画开始的时间 (ms)，包含延迟
  * @return {*}
  ********************************************************************************/
-xanime_t *xanime_create_rt(xanime_obj_t obj, xanime_param_t params)
+xanime_t *xanime_seek(xanime_t *anime, uint32_t time)
 {
-    if (obj.obj_num == 0)
-        return NULL;
-    bool success = false;
-    int32_t dur = str_to_int32(params.dur, &success);
-    if (!success || dur <= 0)
-        return NULL;
-
-    xanime_t *anime = malloc(sizeof(xanime_t));
-    if (!anime)
+    group_anim_t *g = anime_runner(anime);
+    if (!g)
         return NULL;
-
-    memset(anime, 0, sizeof(xanime_t));
-
-    // 复制对象数组
-    anime->obj.obj_arr = obj.obj_arr;
-    anime->obj.obj_num = obj.obj_num;
-
-    anime->params.x = params.x;
-    anime->params.y = params.y;
-    anime->params.width = params.width;
-    anime->params.height = params.height;
-    anime->params.opacity = params.opacity;
-    anime->params.rotate = params.rotate;
-    anime->params.scale = params.scale;
-    anime->params.dur = params.dur;
-    anime->params.delay = params.delay;
-    anime->params.easing = params.easing;
-    anime->params.loop = params.loop;
-    anime->params.complete_cb = params.complete_cb;
-    anime->params.user_data = params.user_data;
-    anime->params.is_from = params.is_from;
-
-    // 初始化状态
-    anime->is_playing = false;
-
-    // 自动播放
-    if (params.auto_play)
+    if (g->spring_pos)
     {
-        xanime_start(anime);
+        printf("Error: Spring animations have no timeline to seek\n");
+        return NULL;
     }
 
+    uint32_t span = group_span(g);
+    g->elapsed = time < span ? time : span;
+    g->time_frac = 0;
+    driver_wake();
+    // 跳转总是重新写入，覆盖期间对样式的外部修改
+    g->cached = false;
+    // 延迟阶段显示起始值
+    if (g->elapsed < g->delay)
+        group_seek(g, 0);
+    else
+        group_update(g);
     return anime;
 }
 
 /********************************************************************************
- * @brief: 启动动画
+ * @brief: 切换播放方向，从当前位置向反方向播放；已结束的动画会重新开始播放
  * @param {xanime_t*} anime
  * @return {*}
  ********************************************************************************/
-xanime_t *xanime_start(xanime_t *anime)
+xanime_t *xanime_reverse(xanime_t *anime)
 {
-    if (!anime || !anime->obj.obj_arr || anime->is_playing)
-        return anime;
-
-    if (anime->obj.obj_num == 0)
+    group_anim_t *g = anime_runner(anime);
+    if (!g)
+        return NULL;
+    if (g->spring_pos)
     {
+        printf("Error: Spring animations cannot reverse, use xanime_retarget instead\n");
         return NULL;
     }
-    // 循环创建动画
-    for (uint16_t i = 0; i < anime->obj.obj_num; i++)
-    {
-        lv_obj_t *cur_obj = anime->obj.obj_arr[i];
-        // 更新最新布局
-        lv_obj_update_layout(cur_obj);
-        // 初始化动画
-        lv_anim_t a;
-        lv_anim_init(&a);
-        lv_anim_set_var(&a, cur_obj);
-        // lv_anim_set_time(&a, anime->params.dur);
-        // lv_anim_set_delay(&a, anime->params.delay);
-        // lv_anim_set_ready_cb(cur_obj, anime->params.complete_cb);
-        // lv_anim_set_user_data(cur_obj, anime->params.user_data);
-        // lv_anim_set_path_cb(&a, get_easing_func(anime->params.easing));
 
-        anime_param_handle(&a, anime, cur_obj);
+    g->reversed = !g->reversed;
+    driver_wake();
+    if (!anime->is_paused && !g->active)
+    {
+        anime->is_playing = true;
+        group_play(g);
     }
-
-    anime->is_playing = true;
-
-    return anime; // 返回控制器指针以支持链式调用
+    return anime;
 }
 
 /********************************************************************************
- * @brief: 检查参数是否有效
- * @param {char*} param
+ * @brief: 设置时间缩放
+ * @param {xanime_t*} anime
+ * @param {uint16_t} timescale XANIME_TIMESCALE_NORMAL 为 1 倍速，512 为 2 倍速，128 为 0.5 倍速
  * @return {*}
  ********************************************************************************/
-bool check_param(char *param)
+xanime_t *xanime_set_timescale(xanime_t *anime, uint16_t timescale)
 {
-    if (param == NULL || param[0] == '\0' || strcmp(param, "") == 0)
+    if (timescale == 0)
     {
-        return false;
+        printf("Error: Invalid timescale 0, use xanime_pause instead\n");
+        return NULL;
     }
-    return true;
+    group_anim_t *g = anime_runner(anime);
+    if (!g)
+        return NULL;
+
+    g->timescale = timescale;
+    g->time_frac = 0;
+    driver_wake();
+    return anime;
 }
 
 /********************************************************************************
- * @brief: 处理动画参数
- * @param {lv_anim_t*} anim
+ * @brief: 从头正向播放，复用第一次启动时解析的起止值
  * @param {xanime_t*} anime
- * @param {lv_obj_t*} obj
  * @return {*}
  ********************************************************************************/
-void anime_param_handle(lv_anim_t *anim, xanime_t *anime, lv_obj_t *obj)
+xanime_t *xanime_restart(xanime_t *anime)
 {
-    // duration
-    if (check_param(anime->params.dur))
-    {
-        bool success = false;
-        int32_t dur = str_to_int32(anime->params.dur, &success);
-        if (!success)
-        {
-            printf("Error: Invalid dur value '%s'\n", anime->params.dur);
-            return;
-        }
-        lv_anim_set_time(anim, dur);
-    }
-    // delay
-    if (check_param(anime->params.delay))
-    {
-        bool success = false;
-        int32_t delay = str_to_int32(anime->params.delay, &success);
-        if (!success)
-        {
-            printf("Error: Invalid delay value '%s'\n", anime->params.delay);
-            return;
-        }
-        lv_anim_set_delay(anim, delay);
-    }
-    // complete callback
-    if (anime->params.complete_cb != NULL)
-    {
-        lv_anim_set_ready_cb(anim, anime->params.complete_cb);
-    }
+    group_anim_t *g = anime_runner(anime);
+    if (!g)
+        return NULL;
 
-    // loop
-    if (check_param(anime->params.loop))
-    {
-        bool success = false;
-        int32_t loop = str_to_int32(anime->params.loop, &success);
-        if (!success)
-        {
-            printf("Error: Invalid loop value '%s'\n", anime->params.loop);
-            return;
-        }
-        lv_anim_set_repeat_count(anim, loop < 0 ? LV_ANIM_REPEAT_INFINITE : loop);
-    }
-    // user data
-    if (anime->params.user_data != NULL)
+    g->elapsed = 0;
+    g->time_frac = 0;
+    g->loop_idx = 0;
+    g->reversed = false;
+    for (uint8_t c = 0; c < g->ch_num; c++)
+        g->ch[c].seg = 0;
+    g->cached = false;
+    if (g->spring_pos)
+        group_spring_reset(g);
+    // 重新播放时再次停止冲突的动画并恢复被覆盖的属性
+    if (anime->spec.overwrite != XANIME_OVERWRITE_NONE)
     {
-        lv_anim_set_user_data(anim, anime->params.user_data);
+        overwrite_conflicts(anime);
+        group_claim(g);
     }
-    // easing
-    if (anime->params.easing < XANIME_EASE_COUNT)
-    {
-        lv_anim_set_path_cb(anim, get_easing_func(anime->params.easing));
-    }
-    // x
-    if (check_param(anime->params.x))
+    group_seek(g, 0);
+
+    anime->is_paused = false;
+    anime->is_playing = true;
+    // 已在播放时只重置时钟
+    g->node.last_tick = lv_tick_get();
+    group_play(g);
+    anime_emit(anime, XANIME_EVENT_START);
+    return anime;
+}
+
+/********************************************************************************
+ * @brief: 获取弹簧动画及其属性所在的通道，尚未启动时先解析并停在起始状态
+ * @param {xanime_t*} anime
+ * @param {xanime_prop_t} prop
+ * @param {group_channel_t**} ch
+ * @return {*} 不是弹簧动画或没有该属性时返回 NULL
+ ********************************************************************************/
+static group_anim_t *spring_runner(xanime_t *anime, xanime_prop_t prop, group_channel_t **ch)
+{
+    if (!anime || !anime->spec.is_spring)
     {
-        int32_t start = lv_obj_get_x(obj);
-        char x_str[12];
-        if (has_percent(anime->params.x))
-        {
-            // 复制字符串
-            strcpy(x_str, anime->params.x);
-            // 移除字符串中的%
-            remove_percent_chars(x_str);
-            int32_to_str(get_x_percent(obj, x_str), x_str, 12);
-            add_anim_property(anime, anim, (lv_anim_exec_xcb_t)lv_obj_set_x, start, x_str);
-        }
-        else
-        {
-            add_anim_property(anime, anim, (lv_anim_exec_xcb_t)lv_obj_set_x, start, anime->params.x);
-        }
+        printf("Error: Retargeting requires a spring animation\n");
+        return NULL;
     }
-    // y
-    if (check_param(anime->params.y))
+    group_anim_t *g = anime_runner(anime);
+    if (!g)
+        return NULL;
+    for (uint8_t c = 0; c < g->ch_num; c++)
     {
-        int32_t start = lv_obj_get_y(obj);
-        char y_str[12];
-        if (has_percent(anime->params.y))
-        {
-            // 复制字符串
-            strcpy(y_str, anime->params.y);
-            // 移除字符串中的%
-            remove_percent_chars(y_str);
-            int32_to_str(get_y_percent(obj, y_str), y_str, 12);
-            add_anim_property(anime, anim, (lv_anim_exec_xcb_t)lv_obj_set_y, start, y_str);
-        }
-        else
+        if (g->ch[c].prop == prop)
         {
-            add_anim_property(anime, anim, (lv_anim_exec_xcb_t)lv_obj_set_y, start, anime->params.y);
+            *ch = &g->ch[c];
+            return g;
         }
     }
-    // width
-    if (check_param(anime->params.width))
-    {
-        int32_t start = lv_obj_get_width(obj);
+    printf("Error: Property %s is not animated by the spring\n", (uint32_t)prop < ANIM_PROP_COUNT ? prop_name(prop) : "?");
+    return NULL;
+}
 
-        char width_str[12];
-        if (has_percent(anime->params.width))
-        {
-            // 复制字符串
-            strcpy(width_str, anime->params.width);
-            // 移除字符串中的%
-            remove_percent_chars(width_str);
-            int32_to_str(get_width_percent(obj, width_str), width_str, 12);
-            add_anim_property(anime, anim, (lv_anim_exec_xcb_t)lv_obj_set_width, start, width_str);
-        }
-        else
-        {
-            add_anim_property(anime, anim, (lv_anim_exec_xcb_t)lv_obj_set_width, start, anime->params.width);
-        }
-    }
-    // height
-    if (check_param(anime->params.height))
-    {
-        int32_t start = lv_obj_get_height(obj);
-        char height_str[12];
-        if (has_percent(anime->params.height))
-        {
-            // 复制字符串
-            strcpy(height_str, anime->params.height);
-            // 移除字符串中的%
-            remove_percent_chars(height_str);
-            int32_to_str(get_height_percent(obj, height_str), height_str, 12);
-            add_anim_property(anime, anim, (lv_anim_exec_xcb_t)lv_obj_set_height, start, height_str);
-        }
-        else
-        {
-            add_anim_property(anime, anim, (lv_anim_exec_xcb_t)lv_obj_set_height, start, anime->params.height);
-        }
-    }
-    // opacity
-    if (check_param(anime->params.opacity))
-    {
-        int32_t start = lv_obj_get_style_opa(obj, LV_PART_MAIN);
-        add_anim_property(anime, anim, opa_exec_cb, start, anime->params.opacity);
-    }
-    // rotate
-    if (check_param(anime->params.rotate))
+/********************************************************************************
+ * @brief: 弹簧的目标或速度改变后继续运动，已静止的弹簧从当前状态重新开始，暂停时等待恢复
+ * @param {xanime_t*} anime
+ * @param {group_anim_t*} g
+ * @return {*}
+ ********************************************************************************/
+static void spring_wake(xanime_t *anime, group_anim_t *g)
+{
+    // 最长时长从最近一次改变开始计算
+    g->spring_base = g->spring_time;
+    driver_wake();
+    if (g->active || anime->is_paused)
+        return;
+    // 结束时释放的覆盖记录重新登记
+    if (anime->spec.overwrite != XANIME_OVERWRITE_NONE)
     {
-        int32_t start = lv_obj_get_style_transform_angle(obj, LV_PART_MAIN);
-        add_anim_property(anime, anim, rotate_exec_cb, start, anime->params.rotate);
+        overwrite_conflicts(anime);
+        group_claim(g);
     }
-    // pivot_x
-    if (check_param(anime->params.pivot_x))
-    {
-        char pivot_str[12];
-        int32_t pivot_x = 0;
-        if (has_percent(anime->params.pivot_x))
-        {
-            // 复制字符串
-            strcpy(pivot_str, anime->params.pivot_x);
-            // 移除字符串中的%
-            remove_percent_chars(pivot_str);
-            // 处理百分比
-            lv_coord_t percent_x = str_to_int32(pivot_str, NULL);
-            // 更新布局以获取图片宽高
-            lv_obj_update_layout(obj);
-            pivot_x = lv_obj_get_width(obj) * percent_x / 100;
-        }
-        else
-        {
-            pivot_x = str_to_int32(anime->params.pivot_x, NULL);
-        }
+    anime->is_playing = true;
+    group_play(g);
+    anime_emit(anime, XANIME_EVENT_START);
+}
 
-        if (is_image_object(obj))
-        {
-            lv_point_t pivot;
-            lv_img_get_pivot(obj, &pivot);
-            printf("pivot_x: %d, pivot_y: %d\n", pivot_x, pivot.y);
-            lv_img_set_pivot(obj, pivot_x, pivot.y);
-        }
-        else
-        {
-            lv_obj_set_style_transform_pivot_x(obj, pivot_x, LV_PART_MAIN);
-        }
-    }
-    // pivot_y
-    if (check_param(anime->params.pivot_y))
-    {
-        char pivot_str[12];
-        int32_t pivot_y = 0;
-        if (has_percent(anime->params.pivot_y))
-        {
-            // 复制字符串
-            strcpy(pivot_str, anime->params.pivot_y);
-            // 移除字符串中的%
-            remove_percent_chars(pivot_str);
-            // 处理百分比
-            lv_coord_t percent_y = str_to_int32(pivot_str, NULL);
-            // 更新布局以获取图片宽高
-            lv_obj_update_layout(obj);
-            pivot_y = lv_obj_get_height(obj) * percent_y / 100;
-        }
-        else
-        {
-            pivot_y = str_to_int32(anime->params.pivot_y, NULL);
-        }
+/********************************************************************************
+ * @brief: 改变弹簧的目标值，保留当前位置与速度，运动中途改变不会跳变
+ * @param {xanime_t*} anime
+ * @param {xanime_prop_t} prop
+ * @param {xanime_value_t} value 相对值相对当前目标值
+ * @return {*}
+ ********************************************************************************/
+xanime_t *xanime_retarget(xanime_t *anime, xanime_prop_t prop, xanime_value_t value)
+{
+    group_channel_t *ch;
+    group_anim_t *g = spring_runner(anime, prop, &ch);
+    if (!g)
+        return NULL;
 
-        if (is_image_object(obj))
-        {
-            lv_point_t pivot;
-            lv_img_get_pivot(obj, &pivot);
-            lv_img_set_pivot(obj, pivot.x, pivot_y);
-        }
-        else
-        {
-            lv_obj_set_style_transform_pivot_y(obj, pivot_y, LV_PART_MAIN);
-        }
-    }
-    // scale
-    if (check_param(anime->params.scale))
+    int32_t *to = ch->values + g->obj_num;
+    geom_snapshot_t geom = {0};
+    for (uint16_t i = 0; i < g->obj_num; i++)
     {
-        int32_t start = lv_obj_get_style_transform_scale_x(obj, LV_PART_MAIN);
-        add_anim_property(anime, anim, zoom_exec_cb, start, anime->params.scale);
+        if (!g->objs[i])
+            continue;
+        if (value.unit == XANIME_UNIT_PERCENT)
+            geom_snapshot(&geom, g->objs[i]);
+        to[i] = resolve_value(prop, &geom, value, to[i]);
     }
+    spring_wake(anime, g);
+    return anime;
+}
+
+/********************************************************************************
+ * @brief: 设置弹簧所有对象在该属性上的速度，刚度为 0 时即惯性滑动的初速度
+ * @param {xanime_t*} anime
+ * @param {xanime_prop_t} prop
+ * @param {int32_t} velocity 属性单位/秒
+ * @return {*}
+ ********************************************************************************/
+xanime_t *xanime_set_velocity(xanime_t *anime, xanime_prop_t prop, int32_t velocity)
+{
+    group_channel_t *ch;
+    group_anim_t *g = spring_runner(anime, prop, &ch);
+    if (!g)
+        return NULL;
+
+    int64_t *vel = g->spring_vel + (size_t)(ch - g->ch) * g->obj_num;
+    for (uint16_t i = 0; i < g->obj_num; i++)
+        vel[i] = (int64_t)velocity * SPRING_ONE;
+    spring_wake(anime, g);
+    return anime;
+}
+
+/********************************************************************************
+ * @brief: 获取当前播放位置
+ * @param {xanime_t*} anime
+ * @return {*} 相对动画开始的时间 (ms)，包含延迟；无限循环时为当前一轮中的位置
+ ********************************************************************************/
+uint32_t xanime_get_time(xanime_t *anime)
+{
+    if (!anime || !ANIME_PRIV(anime)->runner)
+        return 0;
+    return ANIME_PRIV(anime)->runner->elapsed;
+}
+
+/********************************************************************************
+ * @brief: 获取因数值未变化而跳过的样式写入次数，用于评估重绘开销
+ * @param {xanime_t*} anime
+ * @return {*} 控制器创建以来的累计次数，属性模式由 LVGL 自行跳过，不计入
+ ********************************************************************************/
+uint32_t xanime_get_skipped(const xanime_t *anime)
+{
+    return anime ? ANIME_PRIV(anime)->skip_cnt : 0;
+}
+
+/********************************************************************************
+ * @brief: 获取调度器的负载等级，用于评估是否需要减少动画
+ * @return {*} 0 表示所有动画全速更新，XANIME_LOAD_MAX 表示低优先级动画每 8 帧更新一次
+ ********************************************************************************/
+uint8_t xanime_get_load_level(void)
+{
+    return driver.level;
 }
 
 /********************************************************************************
- * @brief: 添加动画属性
- * @param {lv_anim_t*} anim
- * @param {lv_anim_exec_xcb_t} exec_cb
- * @param {int32_t} start
- * @param {char*} end
+ * @brief: 获取距离下一次需要更新动画的时间，主循环可以据此休眠
+ * @return {*} 毫秒数，0 表示需要在下个刷新周期更新；没有动画时为 XANIME_TIME_INFINITE
+ ********************************************************************************/
+uint32_t xanime_get_idle_time(void)
+{
+    // 属性模式与融合模式由 LVGL 的动画定时器每个刷新周期驱动
+    if (lv_anim_count_running() > 0)
+        return 0;
+    // 还有未派发的事件
+    if (event_queue.count > 0)
+        return 0;
+    if (!driver.head)
+        return XANIME_TIME_INFINITE;
+    uint32_t passed = lv_tick_elaps(driver.run_tick);
+    return passed < driver.period ? driver.period - passed : 0;
+}
+
+/********************************************************************************
+ * @brief: 删除动画控制器
+ * @param {xanime_t*} anime
  * @return {*}
  ********************************************************************************/
-void add_anim_property(xanime_t *anime, lv_anim_t *anim, lv_anim_exec_xcb_t exec_cb, int32_t start, const char *end)
+void xanime_delete(xanime_t *anime)
 {
-    bool success = false;
-    int32_t end_int = str_to_int32(end, &success);
-    if (!success)
-    {
-        printf("Error: Invalid end value '%s'\n", end);
+    if (!anime)
         return;
-    }
-    lv_anim_set_exec_cb(anim, exec_cb);
-    if (anime->params.is_from)
+
+    // 取消仍在运行的动画，不触发完成回调
+    anime_cancel(anime);
+    anime_priv_t *priv = ANIME_PRIV(anime);
+    if (priv->runner)
     {
-        lv_anim_set_values(anim, end_int, start);
+        group_stop(priv->runner);
+        group_free(priv->runner);
+        priv->runner = NULL;
     }
-    else
+    path_lut_put(priv->path_lut);
+    priv->path_lut = NULL;
+    anime->is_playing = false;
+
+    for (uint16_t i = 0; i < anime->obj.obj_num; i++)
     {
-        lv_anim_set_values(anim, start, end_int);
+        if (anime->obj.obj_arr[i])
+            lv_obj_remove_event_cb_with_user_data(anime->obj.obj_arr[i], anime_obj_delete_cb, anime);
     }
-    lv_anim_start(anim);
+
+    if (event_queue.count > 0)
+        event_queue_drop(anime);
+    handle_release(priv->handle);
+    pool_free(XANIME_POOL_ANIME, anime);
+    anime = NULL;
 }
 
 /********************************************************************************
- * @brief: 旋转动画回调函数
- * @param {void*} var
- * @param {int32_t} v
+ * @brief: 获取控制器句柄，句柄在控制器删除后失效
+ * @param {xanime_t*} anime
+ * @return {*} 句柄表已满时返回 XANIME_HANDLE_INVALID
+ ********************************************************************************/
+xanime_handle_t xanime_get_handle(const xanime_t *anime)
+{
+    return anime ? ANIME_PRIV(anime)->handle : XANIME_HANDLE_INVALID;
+}
+
+// 句柄表项，空闲项通过 next_free 连接
+typedef struct
+{
+    xanime_t *anime;
+    uint16_t gen;
+    uint16_t next_free;
+} handle_entry_t;
+
+static handle_entry_t handle_table[XANIME_HANDLE_NUM];
+
+// 空闲链表头 (索引 + 1，0 表示空) 与从未使用过的第一项
+static uint16_t handle_free_head;
+static uint16_t handle_unused;
+
+/********************************************************************************
+ * @brief: 通过句柄获取控制器
+ * @param {xanime_handle_t} handle
+ * @return {*} 控制器已删除时返回 NULL，所有接口都可以安全地传入 NULL
+ ********************************************************************************/
+xanime_t *xanime_from_handle(xanime_handle_t handle)
+{
+    uint32_t index = (handle & 0xFFFF) - 1;
+    if (handle == XANIME_HANDLE_INVALID || index >= XANIME_HANDLE_NUM)
+        return NULL;
+    const handle_entry_t *entry = &handle_table[index];
+    if (!entry->anime || entry->gen != (uint16_t)(handle >> 16))
+        return NULL;
+    return entry->anime;
+}
+
+/********************************************************************************
+ * @brief: 为控制器分配句柄
+ * @param {xanime_t*} anime
  * @return {*}
  ********************************************************************************/
-static void rotate_exec_cb(void *var, int32_t v)
+static xanime_handle_t handle_register(xanime_t *anime)
 {
-    if (is_image_object(var))
+    uint16_t index;
+    if (handle_free_head)
     {
-        lv_img_set_angle(var, v);
+        index = handle_free_head - 1;
+        handle_free_head = handle_table[index].next_free;
+    }
+    else if (handle_unused < XANIME_HANDLE_NUM)
+    {
+        index = handle_unused++;
     }
     else
     {
-        lv_obj_set_style_transform_rotation(var, v, LV_PART_MAIN);
+        return XANIME_HANDLE_INVALID;
     }
+
+    handle_entry_t *entry = &handle_table[index];
+    entry->anime = anime;
+    return ((uint32_t)entry->gen << 16) | (uint32_t)(index + 1);
 }
 
 /********************************************************************************
- * @brief: 透明度动画回调函数
- * @param {void*} var
- * @param {int32_t} v
+ * @brief: 释放句柄，代数加一使旧句柄失效
+ * @param {xanime_handle_t} handle
  * @return {*}
  ********************************************************************************/
-static void opa_exec_cb(void *var, int32_t v)
+static void handle_release(xanime_handle_t handle)
 {
-    lv_obj_set_style_opa(var, (lv_opa_t)v, LV_PART_MAIN);
+    if (!xanime_from_handle(handle))
+        return;
+    uint16_t index = (uint16_t)((handle & 0xFFFF) - 1);
+    handle_entry_t *entry = &handle_table[index];
+    entry->anime = NULL;
+    entry->gen++;
+    entry->next_free = handle_free_head;
+    handle_free_head = index + 1;
 }
 
 /********************************************************************************
- * @brief: 缩放动画回调函数
- * @param {void*} var
- * @param {int32_t} v
+ * @brief: 将控制器事件加入队列，不在动画定时器中调用用户回调
+ * @param {xanime_t*} anime 为 NULL 或没有回调时忽略
+ * @param {xanime_event_t} event
  * @return {*}
  ********************************************************************************/
-static void zoom_exec_cb(void *var, int32_t v)
+static void anime_emit(xanime_t *anime, xanime_event_t event)
 {
-    lv_obj_set_style_transform_scale_x(var, v, LV_PART_MAIN);
-    lv_obj_set_style_transform_scale_y(var, v, LV_PART_MAIN);
+    if (!anime || !anime->spec.event_cb)
+        return;
+    anime_priv_t *priv = ANIME_PRIV(anime);
+    // 更新事件派发前只保留一个
+    if (event == XANIME_EVENT_UPDATE)
+    {
+        if (priv->update_queued)
+            return;
+        priv->update_queued = true;
+    }
+
+    if (event_queue.count == event_queue.size)
+    {
+        uint16_t size = event_queue.size ? event_queue.size * 2 : XANIME_EVENT_QUEUE_SIZE;
+        event_entry_t *items = size > event_queue.size ? XANIME_MALLOC(size * sizeof(event_entry_t)) : NULL;
+        if (!items)
+        {
+            printf("Error: Event queue is full, event %d dropped\n", event);
+            if (event == XANIME_EVENT_UPDATE)
+                priv->update_queued = false;
+            return;
+        }
+        // 按顺序搬到新的队列开头
+        for (uint16_t i = 0; i < event_queue.count; i++)
+            items[i] = event_queue.items[(event_queue.head + i) % event_queue.size];
+        XANIME_FREE(event_queue.items);
+        event_queue.items = items;
+        event_queue.size = size;
+        event_queue.head = 0;
+    }
+    event_queue.items[(event_queue.head + event_queue.count) % event_queue.size] =
+        (event_entry_t){.anime = anime, .event = (uint8_t)event};
+    event_queue.count++;
+
+    if (!event_queue.timer)
+        event_queue.timer = lv_timer_create(event_timer_cb, 0, NULL);
+    else if (event_queue.count == 1)
+        lv_timer_resume(event_queue.timer);
 }
 
 /********************************************************************************
- * @brief: 判断对象是否为图片对象
- * @param {lv_obj_t} *obj
+ * @brief: 派发队列中的事件，回调中产生的事件留到下一次
+ * @param {lv_timer_t*} timer
  * @return {*}
  ********************************************************************************/
-static bool is_image_object(lv_obj_t *obj)
+static void event_timer_cb(lv_timer_t *timer)
 {
-    return lv_obj_has_class(obj, &lv_image_class);
+    for (uint16_t n = event_queue.count; n > 0 && event_queue.count > 0; n--)
+    {
+        event_entry_t entry = event_queue.items[event_queue.head];
+        event_queue.head = (event_queue.head + 1) % event_queue.size;
+        event_queue.count--;
+        xanime_t *anime = entry.anime;
+        if (!anime)
+            continue;
+        if (entry.event == XANIME_EVENT_UPDATE)
+            ANIME_PRIV(anime)->update_queued = false;
+        anime->spec.event_cb(anime, (xanime_event_t)entry.event);
+    }
+    if (event_queue.count == 0)
+        lv_timer_pause(timer);
 }
 
 /********************************************************************************
- * @brief: 获取缓动函数
- * @param {xanime_easing_t} easing
+ * @brief: 控制器删除时丢弃队列中它的事件
+ * @param {xanime_t*} anime
  * @return {*}
  ********************************************************************************/
-static lv_anim_path_cb_t get_easing_func(xanime_easing_t easing)
+static void event_queue_drop(xanime_t *anime)
 {
-    switch (easing)
-    {
-    case XANIME_EASE_LINEAR:
-        return lv_anim_path_linear;
-    case XANIME_EASE_IN_SINE:
-        return lv_anim_path_ease_in;
-    case XANIME_EASE_OUT_SINE:
-        return lv_anim_path_ease_out;
-    case XANIME_EASE_IN_OUT_SINE:
-        return lv_anim_path_ease_in_out;
-    case XANIME_EASE_IN_QUAD:
-        return lv_anim_path_overshoot;
-    case XANIME_EASE_OUT_QUAD:
-        return lv_anim_path_bounce;
-    case XANIME_EASE_IN_OUT_QUAD:
-        return lv_anim_path_step;
-    case XANIME_EASE_IN_CUBIC:
-        return lv_anim_path_bounce;
-    case XANIME_EASE_OUT_CUBIC:
-        return lv_anim_path_overshoot;
-    case XANIME_EASE_IN_OUT_CUBIC:
-        return lv_anim_path_ease_in_out;
-    case XANIME_EASE_IN_QUART:
-        return lv_anim_path_ease_in;
-    case XANIME_EASE_OUT_QUART:
-        return lv_anim_path_ease_out;
-    case XANIME_EASE_IN_OUT_QUART:
-        return lv_anim_path_ease_in_out;
-    case XANIME_EASE_IN_BACK:
-        return lv_anim_path_overshoot;
-    case XANIME_EASE_OUT_BACK:
-        return lv_anim_path_overshoot;
-    case XANIME_EASE_IN_OUT_BACK:
-        return lv_anim_path_overshoot;
-    case XANIME_EASE_IN_ELASTIC:
-        return lv_anim_path_bounce;
-    case XANIME_EASE_OUT_ELASTIC:
-        return lv_anim_path_bounce;
-    case XANIME_EASE_IN_OUT_ELASTIC:
-        return lv_anim_path_bounce;
-    case XANIME_EASE_IN_BOUNCE:
-        return lv_anim_path_bounce;
-    case XANIME_EASE_OUT_BOUNCE:
-        return lv_anim_path_bounce;
-    case XANIME_EASE_IN_OUT_BOUNCE:
-        return lv_anim_path_bounce;
-    default:
-        return lv_anim_path_linear;
+    for (uint16_t i = 0; i < event_queue.count; i++)
+    {
+        event_entry_t *entry = &event_queue.items[(event_queue.head + i) % event_queue.size];
+        if (entry->anime == anime)
+            entry->anime = NULL;
     }
 }
 
+// 块大小按 8 字节对齐
+#define POOL_ALIGN(size) (((size) + 7) & ~(size_t)7)
+
+// 控制器块容纳 XANIME_POOL_OBJ_MAX 个对象，以及属性模式下每个对象的字符串字段属性的 lv_anim 记录，使用更多通道时从堆分配
+#define POOL_ANIME_BLOCK_SIZE \
+    POOL_ALIGN(sizeof(anime_priv_t) + XANIME_POOL_OBJ_MAX * (sizeof(lv_obj_t *) + XANIME_PROP_BG_COLOR * sizeof(anim_slot_t)))
+#define POOL_DATA_BLOCK_SIZE POOL_ALIGN(XANIME_POOL_DATA_SIZE)
+
+// 固定大小的块池，空闲块的开头存放下一个空闲块
+typedef struct
+{
+    uint8_t *mem;
+    uint32_t block_size;
+    uint16_t capacity;
+    // 从未使用过的第一块
+    uint16_t unused;
+    void *free_head;
+    xanime_pool_stats_t stats;
+} block_pool_t;
+
+#if XANIME_POOL_ENABLE
+static uint64_t pool_anime_mem[XANIME_POOL_ANIME_NUM * POOL_ANIME_BLOCK_SIZE / sizeof(uint64_t)];
+static uint64_t pool_data_mem[XANIME_POOL_DATA_NUM * POOL_DATA_BLOCK_SIZE / sizeof(uint64_t)];
+
+static block_pool_t pools[XANIME_POOL_COUNT] = {
+    [XANIME_POOL_ANIME] = {(uint8_t *)pool_anime_mem, POOL_ANIME_BLOCK_SIZE, XANIME_POOL_ANIME_NUM},
+    [XANIME_POOL_DATA] = {(uint8_t *)pool_data_mem, POOL_DATA_BLOCK_SIZE, XANIME_POOL_DATA_NUM},
+};
+#else
+static block_pool_t pools[XANIME_POOL_COUNT];
+#endif
+
 /********************************************************************************
- * @brief: 字符串转换为int32_t
- * @param {char*} str
- * @param {bool*} success
+ * @brief: 从内存池分配，块不够大或已用完时按配置从堆分配
+ * @param {xanime_pool_id_t} id
+ * @param {size_t} size
  * @return {*}
  ********************************************************************************/
-static int32_t str_to_int32(const char *str, bool *success)
+static void *pool_alloc(xanime_pool_id_t id, size_t size)
 {
-    if (!str || !str[0])
-    {
-        if (success)
-            *success = false;
-        return 0;
-    }
-
-    const char *p = str;
-    bool negative = false;
-    int32_t result = 0;
-
-    // 跳过前导空格
-    while (*p == ' ')
-        p++;
+    block_pool_t *pool = &pools[id];
+    void *ptr = NULL;
 
-    // 处理符号
-    if (*p == '-')
+    if (size <= pool->block_size)
     {
-        negative = true;
-        p++;
+        if (pool->free_head)
+        {
+            ptr = pool->free_head;
+            pool->free_head = *(void **)ptr;
+        }
+        else if (pool->unused < pool->capacity)
+        {
+            ptr = pool->mem + (size_t)pool->unused++ * pool->block_size;
+        }
     }
-    else if (*p == '+')
+#if XANIME_POOL_FALLBACK || !XANIME_POOL_ENABLE
+    if (!ptr)
     {
-        p++;
+        ptr = XANIME_MALLOC(size);
+        if (ptr)
+            pool->stats.heap_cnt++;
     }
+#endif
 
-    // 检查是否有有效数字
-    if (!isdigit((unsigned char)*p))
+    if (size > pool->stats.max_size)
+        pool->stats.max_size = (uint32_t)size;
+    if (!ptr)
     {
-        if (success)
-            *success = false;
-        return 0;
+        pool->stats.fail_cnt++;
+        return NULL;
     }
+    if (++pool->stats.used > pool->stats.high_water)
+        pool->stats.high_water = pool->stats.used;
+    return ptr;
+}
 
-    // 主转换循环
-    const int32_t MAX_SAFE = INT32_MAX / 10;
-    const int32_t LAST_DIGIT_MAX = INT32_MAX % 10;
+/********************************************************************************
+ * @brief: 释放到内存池，不在池内的内存交给堆释放
+ * @param {xanime_pool_id_t} id
+ * @param {void*} ptr
+ * @return {*}
+ ********************************************************************************/
+static void pool_free(xanime_pool_id_t id, void *ptr)
+{
+    if (!ptr)
+        return;
+    block_pool_t *pool = &pools[id];
+    pool->stats.used--;
 
-    while (*p)
+    uint8_t *p = ptr;
+    if (pool->mem && p >= pool->mem && p < pool->mem + (size_t)pool->capacity * pool->block_size)
     {
-        if (!isdigit((unsigned char)*p))
-            break;
+        *(void **)ptr = pool->free_head;
+        pool->free_head = ptr;
+        return;
+    }
+    XANIME_FREE(ptr);
+}
 
-        int digit = *p - '0';
+/********************************************************************************
+ * @brief: 获取内存池统计
+ * @param {xanime_pool_id_t} pool
+ * @param {xanime_pool_stats_t*} stats
+ * @return {*}
+ ********************************************************************************/
+void xanime_pool_get_stats(xanime_pool_id_t pool, xanime_pool_stats_t *stats)
+{
+    if (pool >= XANIME_POOL_COUNT || !stats)
+        return;
+    *stats = pools[pool].stats;
+    stats->block_size = pools[pool].block_size;
+    stats->capacity = pools[pool].capacity;
+}
 
-        // 溢出检查 (在乘以10之前)
-        if (result > MAX_SAFE || (result == MAX_SAFE && digit > (negative ? LAST_DIGIT_MAX + 1 : LAST_DIGIT_MAX)))
+/********************************************************************************
+ * @brief: 刷新控制器中所有对象的布局，每个屏幕只刷新一次
+ * @param {xanime_t*} anime
+ * @return {*}
+ ********************************************************************************/
+static void refresh_layout(xanime_t *anime)
+{
+    if (anime->spec.skip_layout)
+        return;
+
+    lv_obj_t *screens[4];
+    uint8_t screen_num = 0;
+    for (uint16_t i = 0; i < anime->obj.obj_num; i++)
+    {
+        if (!anime->obj.obj_arr[i])
+            continue;
+        lv_obj_t *screen = lv_obj_get_screen(anime->obj.obj_arr[i]);
+        bool refreshed = false;
+        for (uint8_t j = 0; j < screen_num; j++)
         {
-            if (success)
-                *success = false;
-            return negative ? INT32_MIN : INT32_MAX;
+            if (screens[j] == screen)
+            {
+                refreshed = true;
+                break;
+            }
         }
-
-        result = result * 10 + digit;
-        p++;
+        if (refreshed)
+            continue;
+        if (screen_num < sizeof(screens) / sizeof(screens[0]))
+            screens[screen_num++] = screen;
+        lv_obj_update_layout(screen);
     }
+}
 
-    // 处理负值
-    if (negative)
+/********************************************************************************
+ * @brief: 判断动画描述中是否有需要几何尺寸的百分比值
+ * @param {xanime_spec_t*} spec
+ * @return {*}
+ ********************************************************************************/
+static bool spec_needs_geom(const xanime_spec_t *spec)
+{
+    for (uint8_t prop = 0; prop < XANIME_PROP_COUNT; prop++)
     {
-        result = -result;
+        if ((spec->mask & XANIME_PROP_BIT(prop)) && spec->values[prop].unit == XANIME_UNIT_PERCENT)
+            return true;
     }
-
-    if (success)
-        *success = true;
-    return result;
+    return false;
 }
 
 /********************************************************************************
- * @brief: 删除动画控制器
- * @param {xanime_t*} anime
+ * @brief: 记录对象与父对象内容区的尺寸，兄弟对象复用父对象的尺寸
+ * @param {geom_snapshot_t*} geom
+ * @param {lv_obj_t*} obj
  * @return {*}
  ********************************************************************************/
-void xanime_delete(xanime_t *anime)
+static void geom_snapshot(geom_snapshot_t *geom, lv_obj_t *obj)
 {
-    if (!anime)
-        return;
-    anime->is_playing = false;
-
-    free(anime);
-    anime = NULL;
+    lv_obj_t *parent = lv_obj_get_parent(obj);
+    if (!geom->parent || parent != geom->parent)
+    {
+        geom->parent = parent;
+        geom->parent_w = parent ? lv_obj_get_content_width(parent) : 0;
+        geom->parent_h = parent ? lv_obj_get_content_height(parent) : 0;
+    }
+    geom->obj_w = lv_obj_get_width(obj);
+    geom->obj_h = lv_obj_get_height(obj);
 }
 
 /********************************************************************************
  * @brief: 获取对象的 X 轴位置百分比
- * @param {lv_obj_t*} obj
- * @param {char*} percent
+ * @param {geom_snapshot_t*} geom
+ * @param {int32_t} percent
  * @return {*}
  ********************************************************************************/
-static int16_t get_x_percent(lv_obj_t *obj, char *percent)
+static int32_t get_x_percent(const geom_snapshot_t *geom, int32_t percent)
 {
-    int16_t percent_int = str_to_int32(percent, NULL);
-    int16_t parent_w = lv_obj_get_content_width(lv_obj_get_parent(obj));
-    int16_t obj_w = lv_obj_get_width(obj);
-    return ((parent_w - obj_w) * percent_int / 100); // 居中计算
+    return ((geom->parent_w - geom->obj_w) * percent / 100); // 居中计算
 }
 
 /********************************************************************************
  * @brief: 获取对象的 Y 轴位置百分比
- * @param {lv_obj_t*} obj
- * @param {char*} percent
+ * @param {geom_snapshot_t*} geom
+ * @param {int32_t} percent
  * @return {*}
  ********************************************************************************/
-static int16_t get_y_percent(lv_obj_t *obj, char *percent)
+static int32_t get_y_percent(const geom_snapshot_t *geom, int32_t percent)
 {
-    int16_t percent_int = str_to_int32(percent, NULL);
-    lv_coord_t parent_h = lv_obj_get_content_height(lv_obj_get_parent(obj));
-    lv_coord_t obj_h = lv_obj_get_height(obj);
-    return ((parent_h - obj_h) * percent_int / 100);
+    return ((geom->parent_h - geom->obj_h) * percent / 100);
 }
 
 /********************************************************************************
  * @brief: 获取对象的高度百分比
- * @param {lv_obj_t*} obj
- * @param {char*} percent
+ * @param {geom_snapshot_t*} geom
+ * @param {int32_t} percent
  * @return {*}
  ********************************************************************************/
-static int16_t get_height_percent(lv_obj_t *obj, char *percent)
+static int32_t get_height_percent(const geom_snapshot_t *geom, int32_t percent)
 {
-    int16_t percent_int = str_to_int32(percent, NULL);
-    return ((lv_obj_get_content_height(lv_obj_get_parent(obj)) * percent_int) / 100);
+    return ((geom->parent_h * percent) / 100);
 }
 /********************************************************************************
  * @brief: 获取对象的宽度百分比
- * @param {lv_obj_t*} obj
- * @param {char*} percent
+ * @param {geom_snapshot_t*} geom
+ * @param {int32_t} percent
  * @return {*}
  ********************************************************************************/
-static int16_t get_width_percent(lv_obj_t *obj, char *percent)
+static int32_t get_width_percent(const geom_snapshot_t *geom, int32_t percent)
 {
-    int16_t percent_int = str_to_int32(percent, NULL);
-    return ((lv_obj_get_content_width(lv_obj_get_parent(obj)) * percent_int) / 100);
+    return ((geom->parent_w * percent) / 100);
 }
 
 /********************************************************************************
- * @brief: 检查字符串是否包含 '%' 字符
+ * @brief: 解析带单位的数值字符串，支持 "50"、"50%"、"+=50"、"-=50"
  * @param {char*} str
- * @return {*}
+ * @param {xanime_value_t*} out
+ * @return {*} 字符串完整合法时返回 true
  ********************************************************************************/
-static bool has_percent(const char *str)
+static bool parse_value(const char *str, xanime_value_t *out)
 {
-    if (!str)
+    if (!str || !out)
         return false;
-    while (*str)
+
+    const char *p = str;
+    bool success = false;
+    out->unit = XANIME_UNIT_PX;
+
+    // 跳过前导空格
+    while (*p == ' ')
+        p++;
+
+    // 相对值 "+=" / "-="
+    bool rel_negative = false;
+    if ((p[0] == '+' || p[0] == '-') && p[1] == '=')
     {
-        if (*str == '%')
-            return true;
-        str++;
+        out->unit = XANIME_UNIT_REL;
+        rel_negative = p[0] == '-';
+        p += 2;
     }
-    return false;
-}
 
-/********************************************************************************
- * @brief: 移除字符串中所有的 '%' 字符
- * @param {char*} str
- * @return {*}
- ********************************************************************************/
-static void remove_percent_chars(char *str)
-{
-    if (!str)
-        return;
+    out->value = str_to_int32(p, &success);
+    if (!success)
+        return false;
+    if (rel_negative)
+        out->value = -out->value;
 
-    char *read_ptr = str;
-    char *write_ptr = str;
+    // 跳过已转换的符号与数字
+    while (*p == ' ')
+        p++;
+    if (*p == '-' || *p == '+')
+        p++;
+    while (isdigit((unsigned char)*p))
+        p++;
 
-    while (*read_ptr)
+    // 百分比
+    if (*p == '%')
     {
-        if (*read_ptr != '%')
-        {
-            *write_ptr = *read_ptr;
-            write_ptr++;
-        }
-        read_ptr++;
+        if (out->unit == XANIME_UNIT_REL)
+            return false;
+        out->unit = XANIME_UNIT_PERCENT;
+        p++;
     }
-    *write_ptr = '\0'; // 终止字符串
+
+    // 只允许尾随空格
+    while (*p == ' ')
+        p++;
+    return *p == '\0';
 }
 
 /********************************************************************************
- * @brief: int32_t 转换为字符串
- * @param {int32_t} value
- * @param {char*} buffer
- * @param {size_t} bufsize
- * @return {*} 成功时返回字符串长度，失败返回-1
+ * @brief: 解析颜色字符串，支持 "#RRGGBB" 与 "#RGB"
+ * @param {char*} str
+ * @param {xanime_value_t*} out 数值为 0xRRGGBB
+ * @return {*} 字符串完整合法时返回 true
  ********************************************************************************/
-static int int32_to_str(int32_t value, char *buffer, size_t bufsize)
+static bool parse_color(const char *str, xanime_value_t *out)
 {
-    // 检查缓冲区是否有效且足够大 (最小需要12字节: -2147483648 + '\0')
-    if (!buffer || bufsize < 12)
-        return -1;
-
-    char *p = buffer;
-    bool negative = value < 0;
-    uint32_t abs_value;
-
-    // 处理最小负数特殊情况 (不能直接取绝对值)
-    if (value == INT32_MIN)
-    {
-        abs_value = (uint32_t)INT32_MAX + 1;
-    }
-    else
-    {
-        abs_value = negative ? (uint32_t)(-value) : (uint32_t)value;
-    }
-
-    // 从末尾开始写入数字
-    char *end = p;
-    do
-    {
-        if ((size_t)(end - buffer) >= bufsize - 1)
-            return -1; // 缓冲区溢出保护
-        *end++ = '0' + (abs_value % 10);
-        abs_value /= 10;
-    } while (abs_value > 0);
+    if (!str || !out)
+        return false;
 
-    // 添加负号
-    if (negative)
-    {
-        if ((size_t)(end - buffer) >= bufsize - 1)
-            return -1;
-        *end++ = '-';
-    }
+    const char *p = str;
+    while (*p == ' ')
+        p++;
+    if (*p++ != '#')
+        return false;
 
-    // 反转字符串
-    *end = '\0';
-    char *start = buffer;
-    while (start < --end)
+    uint32_t rgb = 0;
+    uint8_t digits = 0;
+    while (isxdigit((unsigned char)*p))
     {
-        char tmp = *start;
-        *start++ = *end;
-        *end = tmp;
+        char c = (char)tolower((unsigned char)*p++);
+        rgb = (rgb << 4) | (uint32_t)(c <= '9' ? c - '0' : c - 'a' + 10);
+        digits++;
     }
+    while (*p == ' ')
+        p++;
+    if (*p != '\0' || (digits != 6 && digits != 3))
+        return false;
 
-    return (int)(end - buffer);
+    // "#RGB" 每位重复一次
+    if (digits == 3)
+        rgb = ((rgb & 0xF00) << 12 | (rgb & 0xF00) << 8) | ((rgb & 0x0F0) << 8 | (rgb & 0x0F0) << 4) |
+              ((rgb & 0x00F) << 4 | (rgb & 0x00F));
+    out->unit = XANIME_UNIT_PX;
+    out->value = (int32_t)rgb;
+    return true;
 }
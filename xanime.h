@@ -18,6 +18,115 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+/*********************
+ *  内存配置，可以在编译选项中覆盖
+ *********************/
+
+// 使用静态内存池分配控制器与通道表
+#ifndef XANIME_POOL_ENABLE
+#define XANIME_POOL_ENABLE 0
+#endif
+
+// 控制器池的块数量
+#ifndef XANIME_POOL_ANIME_NUM
+#define XANIME_POOL_ANIME_NUM 16
+#endif
+
+// 控制器块能容纳的最大对象数量，对象更多的控制器从堆分配
+#ifndef XANIME_POOL_OBJ_MAX
+#define XANIME_POOL_OBJ_MAX 8
+#endif
+
+// 通道表池 (融合动画通道表、组动画关键帧数据) 的块数量与块大小 (字节)
+#ifndef XANIME_POOL_DATA_NUM
+#define XANIME_POOL_DATA_NUM 32
+#endif
+#ifndef XANIME_POOL_DATA_SIZE
+#define XANIME_POOL_DATA_SIZE 256
+#endif
+
+// 池用完或块不够大时从堆分配，为 0 时分配失败
+#ifndef XANIME_POOL_FALLBACK
+#define XANIME_POOL_FALLBACK 1
+#endif
+
+// 堆分配使用 lv_malloc / lv_realloc / lv_free
+// 也可以直接定义 XANIME_MALLOC / XANIME_REALLOC / XANIME_FREE 使用自己的分配器
+#ifndef XANIME_USE_LV_MALLOC
+#define XANIME_USE_LV_MALLOC 0
+#endif
+
+// 自定义贝塞尔缓动的数量 (不超过 8)，每条占用 258 字节
+#ifndef XANIME_EASING_CUSTOM_NUM
+#define XANIME_EASING_CUSTOM_NUM 4
+#endif
+
+// 自定义动画通道的数量 (不超过 9)
+#ifndef XANIME_CHANNEL_CUSTOM_NUM
+#define XANIME_CHANNEL_CUSTOM_NUM 4
+#endif
+
+// 运动路径的弧长均分份数，每帧求值从对应份的起点开始查找
+#ifndef XANIME_PATH_LUT_SIZE
+#define XANIME_PATH_LUT_SIZE 32
+#endif
+
+// 贝塞尔路径每段展开的折线数量
+#ifndef XANIME_PATH_BEZIER_STEPS
+#define XANIME_PATH_BEZIER_STEPS 16
+#endif
+
+// 弹簧积分的固定步长 (ms)，刚度或阻尼过大时自动减小
+#ifndef XANIME_SPRING_STEP
+#define XANIME_SPRING_STEP 4
+#endif
+
+// 弹簧默认的静止速度 (单位/秒)
+#ifndef XANIME_SPRING_REST_SPEED
+#define XANIME_SPRING_REST_SPEED 20
+#endif
+
+// 未设置 dur 时弹簧的最长时长 (ms)
+#ifndef XANIME_SPRING_DUR_MAX
+#define XANIME_SPRING_DUR_MAX 10000
+#endif
+
+// 批量插值使用 SIMD 指令 (AVX2 / SSE2 / NEON，按编译目标选择)，为 0 时使用标量实现
+#ifndef XANIME_USE_SIMD
+#define XANIME_USE_SIMD 1
+#endif
+
+// 快照动画的内存预算 (字节)，同时存在的快照共用，超出后回退为实时渲染
+#ifndef XANIME_SNAPSHOT_BUDGET
+#define XANIME_SNAPSHOT_BUDGET (256 * 1024)
+#endif
+
+// 组模式与融合模式跳过不可见对象 (隐藏、在父对象显示区域之外或不在活动屏幕上) 的写入，可见后直接写入当前时间的值
+#ifndef XANIME_CULL_ENABLE
+#define XANIME_CULL_ENABLE 1
+#endif
+
+// 重新检测可见性的间隔 (ms)，0 表示每帧检测
+#ifndef XANIME_CULL_PERIOD
+#define XANIME_CULL_PERIOD 0
+#endif
+
+// 每帧的时间预算 (ms)，动画更新与渲染超出预算时降低低优先级动画的更新频率，0 表示不限制
+#ifndef XANIME_FRAME_BUDGET
+#define XANIME_FRAME_BUDGET LV_DEF_REFR_PERIOD
+#endif
+
+// 控制器事件队列的初始容量，队列满时加倍
+#ifndef XANIME_EVENT_QUEUE_SIZE
+#define XANIME_EVENT_QUEUE_SIZE 16
+#endif
+
+// 句柄表大小 (不超过 65535)，同时存在的控制器超过该数量时新控制器没有句柄 (xanime_get_handle 返回
+// XANIME_HANDLE_INVALID)；控制器事件不依赖句柄，没有句柄的控制器照常派发
+#ifndef XANIME_HANDLE_NUM
+#define XANIME_HANDLE_NUM 32
+#endif
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -49,8 +158,191 @@ extern "C"
         XANIME_EASE_OUT_BOUNCE,
         XANIME_EASE_IN_OUT_BOUNCE,
         XANIME_EASE_COUNT
+        // 自定义缓动由 xanime_easing_bezier 返回，从 XANIME_EASE_COUNT 开始编号
     } xanime_easing_t;
 
+    // 缓动控制点的定点精度，1024 表示 1.0
+#define XANIME_EASING_ONE 1024
+
+    // 动画驱动方式
+    typedef enum
+    {
+        // 每个属性一个 lv_anim；快照、事件回调、颜色通道与运动路径需要每个对象一个 lv_anim，编译时改为融合模式
+        XANIME_MODE_PROPERTY,
+        // 每个对象一个 lv_anim，进度只计算一次后应用到所有属性
+        XANIME_MODE_FUSED,
+        // 整个控制器共用一个时钟，所有对象与属性在同一循环中推进
+        XANIME_MODE_GROUP,
+    } xanime_mode_t;
+
+    // 动画优先级，帧时间超出预算时按优先级降低更新频率
+    typedef enum
+    {
+        // 始终每帧更新
+        XANIME_PRIORITY_HIGH,
+        // 低优先级降到 1/4 后开始降频，最低 1/2
+        XANIME_PRIORITY_NORMAL,
+        // 装饰性动画，最先降频，最低 1/8
+        XANIME_PRIORITY_LOW,
+    } xanime_priority_t;
+
+    // 负载等级的最大值
+#define XANIME_LOAD_MAX 3
+
+    // 覆盖策略，启动时处理同一对象上已有的组模式与融合模式动画
+    typedef enum
+    {
+        // 不处理，也不会被其他动画覆盖
+        XANIME_OVERWRITE_NONE,
+        // 只停止冲突的属性，其他属性继续播放
+        XANIME_OVERWRITE_AUTO,
+        // 停止目标对象上的所有属性
+        XANIME_OVERWRITE_ALL,
+    } xanime_overwrite_t;
+
+    // 错开动画的起点，对象按到起点的距离依次开始
+    typedef enum
+    {
+        // 从第一个对象开始
+        XANIME_STAGGER_FIRST,
+        // 从中间向两端 (网格为从中心向外)
+        XANIME_STAGGER_CENTER,
+        // 从最后一个对象开始
+        XANIME_STAGGER_LAST,
+    } xanime_stagger_from_t;
+
+    // 控制器事件，每个控制器派发一次，与对象和属性的数量无关
+    typedef enum
+    {
+        // 开始或重新播放
+        XANIME_EVENT_START,
+        // 写入了新的值，尚未派发时多帧合并为一次
+        XANIME_EVENT_UPDATE,
+        // 开始新的一轮循环
+        XANIME_EVENT_REPEAT,
+        // 所有对象播放完成，被覆盖或取消的动画不派发
+        XANIME_EVENT_COMPLETE,
+    } xanime_event_t;
+
+    struct _xanime_t;
+
+    // 控制器事件回调，在动画定时器之后由事件队列派发
+    typedef void (*xanime_event_cb_t)(struct _xanime_t *anime, xanime_event_t event);
+
+    // 可编译的属性索引，前 7 个与 pivot 对应 xanime_param_t 中的字符串字段，其余通过 channels 设置
+    typedef enum
+    {
+        XANIME_PROP_X,
+        XANIME_PROP_Y,
+        XANIME_PROP_WIDTH,
+        XANIME_PROP_HEIGHT,
+        XANIME_PROP_OPACITY,
+        XANIME_PROP_ROTATE,
+        XANIME_PROP_SCALE,
+        // 背景、边框与文字颜色，按 RGB 分量插值
+        XANIME_PROP_BG_COLOR,
+        XANIME_PROP_BORDER_COLOR,
+        XANIME_PROP_TEXT_COLOR,
+        XANIME_PROP_BORDER_WIDTH,
+        XANIME_PROP_SHADOW_WIDTH,
+        XANIME_PROP_TRANSLATE_X,
+        XANIME_PROP_TRANSLATE_Y,
+        XANIME_PROP_LETTER_SPACE,
+        // 自定义通道，由 xanime_channel_register 依次分配
+        XANIME_PROP_CUSTOM,
+        XANIME_PROP_PIVOT_X = XANIME_PROP_CUSTOM + XANIME_CHANNEL_CUSTOM_NUM,
+        XANIME_PROP_PIVOT_Y,
+        XANIME_PROP_COUNT
+    } xanime_prop_t;
+
+    // 可动画的属性数量，pivot 只在启动时设置一次
+#define XANIME_PROP_ANIM_COUNT XANIME_PROP_PIVOT_X
+
+    // 属性位图
+#define XANIME_PROP_BIT(prop) ((uint32_t)1 << (prop))
+
+    // 通道的数值类型
+    typedef enum
+    {
+        // 整数，直接线性插值
+        XANIME_VALUE_INT,
+        // 0xRRGGBB 打包的颜色，每个分量分别插值
+        XANIME_VALUE_COLOR,
+    } xanime_value_type_t;
+
+    // 通道写入后的失效范围，决定能否剔除与使用快照
+    typedef enum
+    {
+        // 只需要重绘对象 (颜色、边框等样式)
+        XANIME_INVALIDATE_REDRAW,
+        // 透明度与变换，可以直接作用在快照上
+        XANIME_INVALIDATE_TRANSFORM,
+        // 改变对象的位置或尺寸，可能让对象重新进入显示区域
+        XANIME_INVALIDATE_LAYOUT,
+    } xanime_invalidate_t;
+
+    // 通道描述
+    typedef struct
+    {
+        // 名称，用于错误输出，需要一直有效
+        const char *name;
+        // 读取当前值，颜色返回 0xRRGGBB
+        int32_t (*get)(lv_obj_t *obj);
+        // 写入新值，签名与 lv_anim 的执行回调相同
+        lv_anim_exec_xcb_t set;
+        xanime_value_type_t type;
+        xanime_invalidate_t invalidate;
+        // 100% 对应的值，0 表示不支持百分比
+        int32_t percent_ref;
+    } xanime_channel_t;
+
+    // 通道与目标值，字符串格式与 xanime_param_t 的字段相同，颜色为 "#RRGGBB" 或 "#RGB"
+    typedef struct
+    {
+        xanime_prop_t prop;
+        const char *value;
+    } xanime_channel_value_t;
+
+    // 运动路径类型
+    typedef enum
+    {
+        // 依次经过所有点的折线
+        XANIME_PATH_POLYLINE,
+        // 首尾相接的三次贝塞尔曲线：起点, 控制点 1, 控制点 2, 终点, 控制点 1, ...，共 3n+1 个点
+        XANIME_PATH_BEZIER,
+    } xanime_path_type_t;
+
+    // 运动路径，对象按弧长匀速经过路径，缓动作用在整条路径上
+    typedef struct
+    {
+        xanime_path_type_t type;
+        // 父对象内的坐标 (与 x / y 相同)，需要一直有效
+        const lv_point_t *points;
+        uint16_t point_num;
+        // 坐标为相对对象起始位置的偏移，多个对象沿同一形状各自运动
+        bool relative;
+        // 旋转对象朝向切线方向
+        bool auto_rotate;
+        // 朝向切线时额外的旋转角度 (0.1 度)
+        int16_t rotate_offset;
+    } xanime_path_t;
+
+    // 弹簧质量的基准值，表示 1.0
+#define XANIME_SPRING_MASS_ONE 256
+
+    // 弹簧参数，位移与速度使用属性自身的单位 (像素、0.1 度、缩放等)
+    typedef struct
+    {
+        // 刚度，0 为惯性滑动：只按阻尼减速，不回到目标值
+        uint16_t stiffness;
+        // 阻尼
+        uint16_t damping;
+        // 质量 (XANIME_SPRING_MASS_ONE 表示 1.0)，0 按 1.0
+        uint16_t mass;
+        // 速度低于该值 (单位/秒) 且与目标相差不到半个单位时静止，0 按 XANIME_SPRING_REST_SPEED
+        uint16_t rest_speed;
+    } xanime_spring_t;
+
     // 动画参数结构
     typedef struct
     {
@@ -74,16 +366,55 @@ extern "C"
         char *delay;
         // 循环次数 (0=不循环, -1=无限循环)
         char *loop;
+        // 相邻对象开始时间的间隔 (ms)，多个对象时依次开始
+        char *stagger;
         // 旋转中心 x
         char *pivot_x;
         // 旋转中心 y
         char *pivot_y;
+        // 其他通道 (颜色、边框、自定义通道等) 的目标值，只在创建时读取
+        const xanime_channel_value_t *channels;
+        uint8_t channel_num;
+        // 运动路径，设置后代替 x / y (与自动旋转时的 rotate)
+        const xanime_path_t *path;
+        // 弹簧参数，设置后按弹簧运动到目标值并在静止时结束，dur 为可选的最长时长；只在创建时读取
+        const xanime_spring_t *spring;
         // 自动播放
         bool auto_play;
         // 从设定值反向执行动画
         bool is_from;
+        // 跳过启动时的布局刷新，调用方已确保布局有效
+        bool skip_layout;
+        // 位置动画使用 translate 样式，终点坐标只在开始时提交一次，播放中不触发布局
+        bool use_translate;
+        // 尺寸动画使用缩放变换 (FLIP)，真实尺寸只在开始与每个关键帧提交，子对象不再每帧重新布局
+        bool flip_size;
+        // 只有透明度、旋转与缩放动画时，开始时把对象渲染为快照，播放中只变换快照图片
+        bool snapshot;
+        // 图片旋转预渲染的帧数 (0 表示不使用)，播放中只切换帧，角度精度为 360 / sprite_frames 度
+        uint8_t sprite_frames;
+        // 数值变化小于该值时跳过写入 (0 和 1 只跳过相同值)，关键帧值总会写入
+        uint8_t threshold;
         // 缓动函数
         xanime_easing_t easing;
+        // 驱动方式，属性模式在需要时编译为融合模式 (见 XANIME_MODE_PROPERTY)
+        xanime_mode_t mode;
+        // 优先级，组模式与融合模式有效
+        xanime_priority_t priority;
+        // 最高更新帧率 (0 表示不限制)，按驱动周期的整数倍取整，属性模式无效
+        // 只有组模式会延长驱动定时器的周期、增加 xanime_get_idle_time 的空闲时间；融合模式的 lv_anim
+        // 仍每个刷新周期运行，只减少写入与重绘，不能用来省电
+        uint8_t fps;
+        // 覆盖策略，被覆盖的属性停在当前值，新动画从当前值开始
+        xanime_overwrite_t overwrite;
+        // 错开的起点
+        xanime_stagger_from_t stagger_from;
+        // 网格列数 (0 表示排成一行)，按网格中的距离错开
+        uint16_t stagger_grid;
+        // 错开时间按距离比例的缓动，XANIME_EASE_LINEAR 为等间隔
+        xanime_easing_t stagger_easing;
+        // 控制器事件回调，需要有返回值的控制器
+        xanime_event_cb_t event_cb;
         // 动画完成回调
         lv_anim_ready_cb_t complete_cb;
         // 用户数据
@@ -96,17 +427,187 @@ extern "C"
         lv_obj_t **obj_arr;
     } xanime_obj_t;
 
-    // 内部动画结构
+    // xanime_compile 错误位图中的路径、未注册通道与时间字段
+#define XANIME_ERR_PATH ((uint32_t)1 << 26)
+#define XANIME_ERR_CHANNEL ((uint32_t)1 << 27)
+#define XANIME_ERR_STAGGER ((uint32_t)1 << 28)
+#define XANIME_ERR_DUR ((uint32_t)1 << 29)
+#define XANIME_ERR_DELAY ((uint32_t)1 << 30)
+#define XANIME_ERR_LOOP ((uint32_t)1 << 31)
+
+    // 数值单位
+    typedef enum
+    {
+        // 绝对像素值 "50"
+        XANIME_UNIT_PX,
+        // 百分比 "50%"
+        XANIME_UNIT_PERCENT,
+        // 相对当前值 "+=50" / "-=50"
+        XANIME_UNIT_REL,
+    } xanime_unit_t;
+
+    // 带单位的数值
+    typedef struct
+    {
+        int32_t value;
+        uint8_t unit;
+    } xanime_value_t;
+
+#define XANIME_PX(v) ((xanime_value_t){.value = (v), .unit = XANIME_UNIT_PX})
+#define XANIME_PCT(v) ((xanime_value_t){.value = (v), .unit = XANIME_UNIT_PERCENT})
+#define XANIME_REL(v) ((xanime_value_t){.value = (v), .unit = XANIME_UNIT_REL})
+    // 0xRRGGBB 颜色
+#define XANIME_COLOR(rgb) ((xanime_value_t){.value = (int32_t)(rgb), .unit = XANIME_UNIT_PX})
+
+    // 关键帧
+    typedef struct
+    {
+        // 相对动画开始的时间 (ms)
+        uint32_t time;
+        // 关键帧的值
+        xanime_value_t value;
+        // 从上一关键帧到本关键帧的缓动函数
+        xanime_easing_t easing;
+    } xanime_keyframe_t;
+
+    // 关键帧轨道，关键帧按时间升序排列
+    typedef struct
+    {
+        const xanime_keyframe_t *frames;
+        uint16_t num;
+    } xanime_track_t;
+
+    // 编译后的动画描述，启动时不再解析字符串
+    typedef struct
+    {
+        // 已设置的属性位图 (XANIME_PROP_BIT)
+        uint32_t mask;
+        // 属性目标值
+        xanime_value_t values[XANIME_PROP_COUNT];
+        // 关键帧轨道，设置后代替对应属性的目标值
+        xanime_track_t tracks[XANIME_PROP_ANIM_COUNT];
+        // 持续时间 (ms)
+        uint32_t dur;
+        // 延迟时间 (ms)
+        uint32_t delay;
+        // 循环次数 (0=不循环, -1=无限循环)
+        int32_t loop;
+        // 相邻对象开始时间的间隔 (ms)
+        uint32_t stagger;
+        // 自动播放
+        bool auto_play;
+        // 从设定值反向执行动画
+        bool is_from;
+        // 跳过启动时的布局刷新
+        bool skip_layout;
+        // 位置动画使用 translate 样式
+        bool use_translate;
+        // 尺寸动画使用缩放变换
+        bool flip_size;
+        // 使用快照代替对象播放
+        bool snapshot;
+        // 图片旋转预渲染的帧数
+        uint8_t sprite_frames;
+        // 跳过写入的数值变化阈值
+        uint8_t threshold;
+        // 缓动函数
+        xanime_easing_t easing;
+        // 驱动方式，创建控制器时按需要把属性模式改为融合模式
+        xanime_mode_t mode;
+        // 优先级
+        xanime_priority_t priority;
+        // 最高更新帧率，只有组模式能减少唤醒 (见 xanime_param_t)
+        uint8_t fps;
+        // 覆盖策略
+        xanime_overwrite_t overwrite;
+        // 错开的起点、网格列数与缓动
+        xanime_stagger_from_t stagger_from;
+        uint16_t stagger_grid;
+        xanime_easing_t stagger_easing;
+        // 运动路径
+        const xanime_path_t *path;
+        // 弹簧参数，is_spring 为 false 时不使用
+        bool is_spring;
+        xanime_spring_t spring;
+        // 控制器事件回调
+        xanime_event_cb_t event_cb;
+        // 动画完成回调
+        lv_anim_ready_cb_t complete_cb;
+        // 用户数据
+        void *user_data;
+    } xanime_spec_t;
+
+    // 时间轴，按顺序或并行组合多个动画控制器，由一个主时钟驱动
+    typedef struct _xanime_timeline_t xanime_timeline_t;
+
+    // 时间轴标签名最大长度 (含结束符)
+#define XANIME_TIMELINE_LABEL_LEN 16
+
+    // 无限时长
+#define XANIME_TIME_INFINITE UINT32_MAX
+
+    // 时间缩放的基准值，表示 1 倍速
+#define XANIME_TIMESCALE_NORMAL 256
+
+    // 控制器句柄，高 16 位为代数，低 16 位为句柄表索引 + 1
+    typedef uint32_t xanime_handle_t;
+
+#define XANIME_HANDLE_INVALID 0
+
+    // 内存池
+    typedef enum
+    {
+        // 控制器、对象数组与 lv_anim 记录
+        XANIME_POOL_ANIME,
+        // 融合动画通道表、组动画关键帧数据
+        XANIME_POOL_DATA,
+        XANIME_POOL_COUNT
+    } xanime_pool_id_t;
+
+    // 内存池统计，用于确定量产配置
     typedef struct
+    {
+        // 块大小与块数量，未启用内存池时为 0
+        uint32_t block_size;
+        uint16_t capacity;
+        // 当前分配数量与历史最大值 (包含从堆分配的)
+        uint16_t used;
+        uint16_t high_water;
+        // 请求过的最大字节数
+        uint32_t max_size;
+        // 从堆分配的次数与分配失败次数
+        uint32_t heap_cnt;
+        uint32_t fail_cnt;
+    } xanime_pool_stats_t;
+
+    // 内部动画结构，运行状态由 xanime.c 管理，只能通过 xanime_create_*_rt 获取
+    typedef struct _xanime_t
     {
         // 目标对象
         xanime_obj_t obj;
         // 动画参数
         xanime_param_t params;
+        // 编译后的动画描述
+        xanime_spec_t spec;
         // 内部状态
         bool is_playing;
+        bool is_paused;
     } xanime_t;
 
+    xanime_easing_t xanime_easing_bezier(int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+
+    xanime_prop_t xanime_channel_register(const xanime_channel_t *channel);
+
+    uint32_t xanime_compile(const xanime_param_t *params, xanime_spec_t *spec);
+
+    void xanime_spec_init(xanime_spec_t *spec, uint32_t dur);
+
+    void xanime_spec_set(xanime_spec_t *spec, xanime_prop_t prop, xanime_value_t value);
+
+    bool xanime_spec_set_track(xanime_spec_t *spec, xanime_prop_t prop, const xanime_keyframe_t *frames, uint16_t num);
+
+    bool xanime_spec_set_path(xanime_spec_t *spec, const xanime_path_t *path);
+
     void xanime_create_single(lv_obj_t *obj, xanime_param_t params);
 
     void xanime_create(xanime_obj_t obj, xanime_param_t params);
@@ -115,10 +616,58 @@ extern "C"
 
     xanime_t *xanime_create_rt(xanime_obj_t obj, xanime_param_t params);
 
+    void xanime_create_spec(xanime_obj_t obj, const xanime_spec_t *spec);
+
+    xanime_t *xanime_create_spec_rt(xanime_obj_t obj, const xanime_spec_t *spec);
+
     xanime_t *xanime_start(xanime_t *anime);
 
+    xanime_t *xanime_pause(xanime_t *anime);
+
+    xanime_t *xanime_resume(xanime_t *anime);
+
+    xanime_t *xanime_seek(xanime_t *anime, uint32_t time);
+
+    xanime_t *xanime_reverse(xanime_t *anime);
+
+    xanime_t *xanime_set_timescale(xanime_t *anime, uint16_t timescale);
+
+    xanime_t *xanime_restart(xanime_t *anime);
+
+    xanime_t *xanime_retarget(xanime_t *anime, xanime_prop_t prop, xanime_value_t value);
+
+    xanime_t *xanime_set_velocity(xanime_t *anime, xanime_prop_t prop, int32_t velocity);
+
+    uint32_t xanime_get_time(xanime_t *anime);
+
+    uint32_t xanime_get_skipped(const xanime_t *anime);
+
+    uint8_t xanime_get_load_level(void);
+
+    uint32_t xanime_get_idle_time(void);
+
     void xanime_delete(xanime_t *anime);
 
+    xanime_handle_t xanime_get_handle(const xanime_t *anime);
+
+    xanime_t *xanime_from_handle(xanime_handle_t handle);
+
+    void xanime_pool_get_stats(xanime_pool_id_t pool, xanime_pool_stats_t *stats);
+
+    xanime_timeline_t *xanime_timeline_create(void);
+
+    bool xanime_timeline_add(xanime_timeline_t *tl, xanime_t *anime, const char *position);
+
+    bool xanime_timeline_add_label(xanime_timeline_t *tl, const char *label, const char *position);
+
+    void xanime_timeline_set_complete_cb(xanime_timeline_t *tl, lv_anim_ready_cb_t complete_cb, void *user_data);
+
+    uint32_t xanime_timeline_get_duration(xanime_timeline_t *tl);
+
+    xanime_timeline_t *xanime_timeline_start(xanime_timeline_t *tl);
+
+    void xanime_timeline_delete(xanime_timeline_t *tl);
+
     void anime_param_handle(lv_anim_t *anim, xanime_t *anime, lv_obj_t *obj);
 
     void add_anim_property(xanime_t *anime, lv_anim_t *anim, lv_anim_exec_xcb_t exec_cb, int32_t start,